@@ -1,7 +1,12 @@
 AF_PATH?=/opt/arrayfire
+# af is the unified backend (select cpu, opencl or cuda at runtime).
+# Use afcpu, afopencl or afcuda to link a single backend.
 AF_LIB_NAME?=af
 AF_FORT=af_fortran
 
+# Optimization flags for the wrapper. Set AF_FORT_OPT= for a debug build.
+AF_FORT_OPT?=-O3 -flto
+
 LIB:=lib
 AF_CFLAGS  = -I$(AF_PATH)/include
 
@@ -9,4 +14,6 @@ AF_FORT_LIB_PATH = $(AF_FORT_PATH)/$(LIB)/
 AF_LIB_PATH      = $(AF_PATH)/$(LIB)/
 
 AF_FORT_LIB=$(AF_FORT_LIB_PATH)/lib$(AF_FORT).so
+AF_FORT_STATIC=$(AF_FORT_LIB_PATH)/lib$(AF_FORT).a
+AF_FORT_OBJ=$(AF_FORT_LIB_PATH)/fortran_wrapper.o
 AF_FORT_FILE=$(AF_FORT_LIB_PATH)/arrayfire.f90
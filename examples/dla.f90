@@ -4,7 +4,9 @@ program dla
 
   type(array) A, B, C, X0, X1, X2
   type(array) l, u, p, r, diff
-  integer :: N
+  type(array) D, Y0, Y
+  integer :: N, iter
+  double precision :: resid
 
   ! Set the size of the matrix
   N = 5
@@ -30,6 +32,14 @@ program dla
   X2 = solve(C, B)
   call print(max(abs(X0 - X2)), "absolute error: Solving positive definite system")
 
+  ! Solve a double precision system with a single precision factorization
+  D = randu(N, N, ty=f64) + identity(N, N, ty=f64) * dble(N)
+  Y0 = randu(N, 1, ty=f64)
+  B = matmul(D, Y0)
+  Y = solve_refined(D, B, iter=iter, resid=resid)
+  write(*,*) "Refinement iterations: ", iter, " relative residual: ", resid
+  call print(max(abs(Y0 - Y)), "absolute error: Solving with iterative refinement")
+
   ! Invert a matrix
   r = inverse(A)
   diff = abs(identity(N, N) - matmul(r, A))
@@ -0,0 +1,25 @@
+! Exits with a non zero status if the backend given on the command line
+! (cpu, opencl or cuda) is not available. Used by the run target.
+program backend_check
+  use arrayfire
+  implicit none
+
+  character(len=16) :: name
+  integer :: b
+
+  call get_command_argument(1, name)
+
+  select case (trim(name))
+  case ("cpu")
+     b = af_backend_cpu
+  case ("opencl")
+     b = af_backend_opencl
+  case ("cuda")
+     b = af_backend_cuda
+  case default
+     write(*,*) "backend_check: unknown backend ", trim(name)
+     stop 2
+  end select
+
+  if (.not. backend_available(b)) stop 1
+end program backend_check
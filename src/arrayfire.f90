@@ -1,5 +1,6 @@
 module arrayfire
-  use, intrinsic :: ISO_C_Binding, only: C_ptr, C_NULL_ptr
+  use, intrinsic :: ISO_C_Binding, only: C_ptr, C_NULL_ptr, C_int, C_float, C_double, &
+                                         C_float_complex, C_double_complex
   implicit none
 
   !> Contains the last known error in the arrayfire module
@@ -16,6 +17,18 @@ module arrayfire
   !> Boolean type
   integer :: b8 = 5
 
+  !> Periodic boundary (shift, stencil)
+  integer, parameter :: af_periodic = 1
+  !> Boundary clamped to the edge value (shift, stencil)
+  integer, parameter :: af_clamped = 2
+
+  !> CPU backend
+  integer, parameter :: af_backend_cpu = 1
+  !> CUDA backend
+  integer, parameter :: af_backend_cuda = 2
+  !> OpenCL backend
+  integer, parameter :: af_backend_opencl = 4
+
   !> type(array) containing information about device
   type array
      !> Dimensions of array
@@ -30,6 +43,12 @@ module arrayfire
      !   procedure :: set => array_set
   end type array
 
+  !> type(graph) containing a recorded sequence of operations
+  type graph
+     !> Recorded operations
+     type(C_ptr) :: ptr = C_NULL_ptr
+  end type graph
+
   !> @defgroup basic Basics
   !! @{
 
@@ -148,7 +167,8 @@ module arrayfire
 
   !> @{
   !> @param[in] in Input array
-  !> @param[in] d1 type(array) denoting indices along 1st dimension
+  !> @param[in] d1 type(array) denoting indices along 1st dimension. When it is the only index,
+  !> it holds linear (column major) indices, e.g. the output of where.
   !> @param[in] d2 type(array) denoting indices along 2nd dimension. Optional.
   !> @param[in] d3 integer denoting the index of the 3rd dimension. Optional.
   !> @param[in] d4 integer denoting the index of the 4th dimension. Optional.
@@ -161,7 +181,8 @@ module arrayfire
   !> @{
   !> @param[in] lhs Array whos values are being set by rhs
   !> @param[in] rhs The value being set
-  !> @param[in] d1 type(array) denoting indices along 1st dimension
+  !> @param[in] d1 type(array) denoting indices along 1st dimension. When it is the only index,
+  !> it holds linear (column major) indices, e.g. the output of where.
   !> @param[in] d2 type(array) denoting indices along 2nd dimension. Optional.
   !> @param[in] d3 integer denoting the index of the 3rd dimension. Optional.
   !> @param[in] d4 integer denoting the index of the 4th dimension. Optional.
@@ -259,6 +280,47 @@ module arrayfire
      module procedure array_join
   end interface join
   !> @}
+
+  !> @{
+  !> Shift an array
+  !> @param[in] A -- an array
+  !> @param[in] s1 -- Shift along the 1st dimension (should be integer)
+  !> @param[in] s2 -- Shift along the 2nd dimension (should be integer, optional, default: 0)
+  !> @param[in] s3 -- Shift along the 3rd dimension (should be integer, optional, default: 0)
+  !> @param[in] s4 -- Shift along the 4th dimension (should be integer, optional, default: 0)
+  !> @param[in] boundary -- af_periodic or af_clamped (optional, default: af_periodic)
+  !> @returns output of the same size as A, such that output(i) = A(i - s)
+  !> @code
+  !! type(array) A, B
+  !! A = randu(5, 5)
+  !! B = shift(A, 1)                       ! Rotate rows down by one
+  !! B = shift(A, 0, -1, boundary=af_clamped) ! Shift columns left, repeating the last column
+  !! @endcode
+  interface shift
+     module procedure array_shift
+  end interface shift
+  !> @}
+
+  !> @{
+  !> Apply a weighted stencil to an array
+  !> @param[in] A -- an array
+  !> @param[in] offsets -- integer array of size (ndims, npoints). Column k holds the offset of point k
+  !> @param[in] weights -- real or double precision array of size npoints
+  !> @param[in] boundary -- af_periodic or af_clamped (optional, default: af_periodic)
+  !> @returns output of the same size as A, such that output(i) = sum_k weights(k) * A(i + offsets(:,k))
+  !> @code
+  !! type(array) U, L
+  !! integer :: offsets(3, 7)
+  !! real :: weights(7)
+  !! U = randu(64, 64, 64)
+  !! offsets = reshape([0,0,0, 1,0,0, -1,0,0, 0,1,0, 0,-1,0, 0,0,1, 0,0,-1], [3, 7])
+  !! weights = [-6, 1, 1, 1, 1, 1, 1]
+  !! L = stencil(U, offsets, weights) ! 7 point laplacian
+  !! @endcode
+  interface stencil
+     module procedure array_stencil_s, array_stencil_d
+  end interface stencil
+  !> @}
   !> @}
 
 
@@ -329,6 +391,72 @@ module arrayfire
      module procedure array_sort
   end interface sort
   !> @}
+
+  !> @{
+  !> Sort an array and return the original locations of the sorted values
+  !> @param[out] out -- Sorted values
+  !> @param[out] idx -- 1-based indices along dim, such that out = A(idx) (integer array, usable with get / set)
+  !> @param[in]  A -- Input array
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @param[in]  ascending -- logical. Optional. Default: .true.
+  !> @code
+  !! type(array) A, B, I
+  !! A = randu(10)
+  !! call sort_index(B, I, A, ascending=.false.)  ! B is the same as get(A, I)
+  !! @endcode
+  interface sort_index
+     module procedure array_sort_index
+  end interface sort_index
+  !> @}
+
+  !> @{
+  !> Sort values by keys
+  !> @param[out] okeys -- Sorted keys
+  !> @param[out] ovals -- Values reordered in the same way as the keys
+  !> @param[in]  keys -- Keys to sort on
+  !> @param[in]  vals -- Values, same size as keys
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @param[in]  ascending -- logical. Optional. Default: .true.
+  !> @code
+  !! type(array) cell, pos, scell, spos
+  !! call sort_by_key(scell, spos, cell, pos)  ! bin particle positions by cell id
+  !! @endcode
+  interface sort_by_key
+     module procedure array_sort_by_key
+  end interface sort_by_key
+  !> @}
+
+  !> @{
+  !> The k largest (or smallest) elements along the first dimension
+  !> @param[out] val -- k values along the first dimension
+  !> @param[out] idx -- 1-based indices of the values (integer array, usable with get / set)
+  !> @param[in]  A -- Input array
+  !> @param[in]  k -- Number of elements to keep
+  !> @param[in]  largest -- logical, .false. returns the k smallest. Optional. Default: .true.
+  !> @code
+  !! type(array) A, V, I
+  !! A = randu(100)
+  !! call topk(V, I, A, 5)
+  !! @endcode
+  interface topk
+     module procedure array_topk
+  end interface topk
+  !> @}
+
+  !> @{
+  !> Locations of the non zero elements of an array
+  !> @param[in]  mask -- Input array
+  !> @returns R -- 1-based linear indices of the non zero elements (integer array, usable with get / set)
+  !> @code
+  !! type(array) A, I, B
+  !! A = randu(100)
+  !! I = where(A > 0.5)
+  !! B = get(A, I)       ! Only the elements greater than 0.5
+  !! @endcode
+  interface where
+     module procedure array_where
+  end interface where
+  !> @}
   !> @}
 
   !> @defgroup extract Extraction: (lower, upper, real, imaginary)
@@ -529,6 +657,55 @@ module arrayfire
 
   !> @}
 
+  !> @defgroup backend Backend selection
+  !> @{
+  !> Switch between the af_backend_cpu, af_backend_opencl and af_backend_cuda backends at runtime.
+  !> Requires the library to be linked against the unified backend (AF_LIB_NAME = af).
+  !> The backend can also be chosen at startup with the environment variable
+  !> AF_FORTRAN_BACKEND=cpu|opencl|cuda. Arrays can not be shared across backends.
+
+  !> @{
+  !> Switch to a backend. Falls back to the cpu backend if it is not available.
+  !> @code
+  !! call backend_set(af_backend_opencl)
+  !! @endcode
+  interface backend_set
+     module procedure backend_set_
+  end interface backend_set
+  !> @}
+
+  !> @{
+  !> Get the active backend
+  !> @code
+  !! if (backend_get() == af_backend_cuda) write(*,*) "Running on CUDA"
+  !! @endcode
+  interface backend_get
+     module procedure backend_get_
+  end interface backend_get
+  !> @}
+
+  !> @{
+  !> Get the number of available backends
+  !> @code
+  !! integer count = backend_count()
+  !! @endcode
+  interface backend_count
+     module procedure backend_count_
+  end interface backend_count
+  !> @}
+
+  !> @{
+  !> Check if a backend is available
+  !> @code
+  !! if (backend_available(af_backend_cuda)) call backend_set(af_backend_cuda)
+  !! @endcode
+  interface backend_available
+     module procedure backend_available_
+  end interface backend_available
+  !> @}
+
+  !> @}
+
   !> @defgroup time Timing code
   !> @{
   !> Functions useful for timing GPU code
@@ -563,6 +740,73 @@ module arrayfire
   end interface timer_stop
   !> @}
 
+  !> @}
+
+  !> @defgroup graph Recording and replaying operations
+  !> @{
+  !> Record the operations of a time step once and replay them on new inputs.
+  !> Element wise and arithmetic operations, reductions along a dimension,
+  !> matmul, transpose, moddims, tile, join, shift, stencil and indexing with
+  !> sequences are recorded. Arrays created from host data or generators while
+  !> recording, and arrays created before graph_begin that are not passed as
+  !> inputs, are kept as constants: the replay uses their values at the time
+  !> of recording. Scalars are constants too, so in U = U + dt * L the replay
+  !> always uses the value dt had during recording. A scalar that changes
+  !> between runs has to be passed as an input array of the same shape, e.g.
+  !> constant(dt, 64, 64). Using any other operation (get / set with array indices,
+  !> factorizations, norms, sorting, imin / imax ..) on a recorded array while
+  !> recording stops the program. Copies to the host while recording return
+  !> the values computed during recording, graph_run does not repeat them.
+  !> @code
+  !! type(graph) g
+  !! type(array) U, L, ins(1), outs(1)
+  !! U = randu(64, 64)
+  !! call graph_begin(g, [U])
+  !! L = shift(U, 1) + shift(U, -1) + shift(U, 0, 1) + shift(U, 0, -1) - 4.0 * U
+  !! U = U + 0.1 * L
+  !! call graph_end(g, [U])
+  !! ins(1) = U
+  !! do i = 1, 100
+  !!    call graph_run(g, ins, outs)
+  !!    ins(1) = outs(1)
+  !! end do
+  !! @endcode
+
+  !> @{
+  !> Start recording operations
+  !> @param[out] g -- type(graph)
+  !> @param[in]  inputs -- Placeholders that are replaced by the inputs of graph_run
+  interface graph_begin
+     module procedure graph_begin_
+  end interface graph_begin
+  !> @}
+
+  !> @{
+  !> Stop recording operations
+  !> @param[inout] g -- type(graph)
+  !> @param[in]    outputs -- Arrays returned by graph_run
+  interface graph_end
+     module procedure graph_end_
+  end interface graph_end
+  !> @}
+
+  !> @{
+  !> Replay the recorded operations
+  !> @param[in]    g -- type(graph)
+  !> @param[in]    inputs -- Same number of arrays as the placeholders given to graph_begin
+  !> @param[inout] outputs -- Same number of arrays as given to graph_end, overwritten in place
+  interface graph_run
+     module procedure graph_run_
+  end interface graph_run
+  !> @}
+
+  !> @{
+  !> Release a recorded graph
+  !> @param[inout] g -- type(graph)
+  interface graph_free
+     module procedure graph_free_
+  end interface graph_free
+  !> @}
   !> @}
   !> @}
 
@@ -796,6 +1040,10 @@ module arrayfire
   !! out = sin(in)        ! similarily cos(in), tan(in)
   !! out = exp(in)        ! similarily log(in)
   !! out = abs(in - 0.5)  ! absolute values
+  !! out = atan2(in, 0.5) ! binary functions take arrays or scalars
+  !! out = max(in, 0.5)   ! element wise; max(in, 2) stays the reduction along dim 2
+  !! out = select(in > 0.5, in, 0.0) ! keep elements above 0.5, zero elsewhere
+  !! out = clamp(in, 0.25, 0.75)
   !! @endcode
   !! @{
 
@@ -851,6 +1099,325 @@ module arrayfire
   end interface abs
   !> @}
 
+  !> @{
+  !> square root of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface sqrt
+     module procedure array_sqrt
+  end interface sqrt
+  !> @}
+
+  !> @{
+  !> cube root of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface cbrt
+     module procedure array_cbrt
+  end interface cbrt
+  !> @}
+
+  !> @{
+  !> inverse sine of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface asin
+     module procedure array_asin
+  end interface asin
+  !> @}
+
+  !> @{
+  !> inverse co-sine of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface acos
+     module procedure array_acos
+  end interface acos
+  !> @}
+
+  !> @{
+  !> inverse tangent of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface atan
+     module procedure array_atan
+  end interface atan
+  !> @}
+
+  !> @{
+  !> hyperbolic sine of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface sinh
+     module procedure array_sinh
+  end interface sinh
+  !> @}
+
+  !> @{
+  !> hyperbolic co-sine of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface cosh
+     module procedure array_cosh
+  end interface cosh
+  !> @}
+
+  !> @{
+  !> hyperbolic tangent of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface tanh
+     module procedure array_tanh
+  end interface tanh
+  !> @}
+
+  !> @{
+  !> inverse hyperbolic sine of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface asinh
+     module procedure array_asinh
+  end interface asinh
+  !> @}
+
+  !> @{
+  !> inverse hyperbolic co-sine of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface acosh
+     module procedure array_acosh
+  end interface acosh
+  !> @}
+
+  !> @{
+  !> inverse hyperbolic tangent of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface atanh
+     module procedure array_atanh
+  end interface atanh
+  !> @}
+
+  !> @{
+  !> base 10 logarithm of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface log10
+     module procedure array_log10
+  end interface log10
+  !> @}
+
+  !> @{
+  !> base 2 logarithm of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface log2
+     module procedure array_log2
+  end interface log2
+  !> @}
+
+  !> @{
+  !> log(1 + x) of an array, accurate for small x
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface log1p
+     module procedure array_log1p
+  end interface log1p
+  !> @}
+
+  !> @{
+  !> exp(x) - 1 of an array, accurate for small x
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface expm1
+     module procedure array_expm1
+  end interface expm1
+  !> @}
+
+  !> @{
+  !> error function of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface erf
+     module procedure array_erf
+  end interface erf
+  !> @}
+
+  !> @{
+  !> complementary error function of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface erfc
+     module procedure array_erfc
+  end interface erfc
+  !> @}
+
+  !> @{
+  !> gamma function of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface gamma
+     module procedure array_tgamma
+  end interface gamma
+  !> @}
+
+  !> @{
+  !> logarithm of the absolute value of the gamma function of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface log_gamma
+     module procedure array_lgamma
+  end interface log_gamma
+  !> @}
+
+  !> @{
+  !> largest integral value not greater than the elements of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface floor
+     module procedure array_floor
+  end interface floor
+  !> @}
+
+  !> @{
+  !> smallest integral value not less than the elements of an array
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface ceiling
+     module procedure array_ceil
+  end interface ceiling
+  !> @}
+
+  !> @{
+  !> nearest integral value of the elements of an array (halfway cases away from zero)
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface anint
+     module procedure array_round
+  end interface anint
+  !> @}
+
+  !> @{
+  !> elements of an array truncated towards zero
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface aint
+     module procedure array_trunc
+  end interface aint
+  !> @}
+
+  !> @{
+  !> sign of an array: -1, 0 or 1 for negative, zero and positive elements
+  !> @param[in] in -- Should be type array
+  !> @returns output which performs the function element wise
+  interface sign
+     module procedure array_sign
+  end interface sign
+  !> @}
+
+  !> @{
+  !> test the elements of an array for NaN
+  !> @param[in] in -- Should be type array
+  !> @returns b8 array, true where the test holds
+  interface isnan
+     module procedure array_isnan
+  end interface isnan
+  !> @}
+
+  !> @{
+  !> test the elements of an array for infinity
+  !> @param[in] in -- Should be type array
+  !> @returns b8 array, true where the test holds
+  interface isinf
+     module procedure array_isinf
+  end interface isinf
+  !> @}
+
+  !> @{
+  !> test the elements of an array for zero
+  !> @param[in] in -- Should be type array
+  !> @returns b8 array, true where the test holds
+  interface iszero
+     module procedure array_iszero
+  end interface iszero
+  !> @}
+
+  !> @{
+  !> inverse tangent of A / B, using the signs of both to find the quadrant
+  !> @param[in] A -- array or scalar (real, double precision or integer)
+  !> @param[in] B -- array or scalar (real, double precision or integer)
+  !> @returns output which performs the function element wise
+  interface atan2
+     module procedure array_atan2
+     module procedure array_atan2_s, array_latan2_s
+     module procedure array_atan2_d, array_latan2_d
+     module procedure array_atan2_i, array_latan2_i
+  end interface atan2
+  !> @}
+
+  !> @{
+  !> sqrt(A**2 + B**2), without undue overflow or underflow
+  !> @param[in] A -- array or scalar (real, double precision or integer)
+  !> @param[in] B -- array or scalar (real, double precision or integer)
+  !> @returns output which performs the function element wise
+  interface hypot
+     module procedure array_hypot
+     module procedure array_hypot_s, array_lhypot_s
+     module procedure array_hypot_d, array_lhypot_d
+     module procedure array_hypot_i, array_lhypot_i
+  end interface hypot
+  !> @}
+
+  !> @{
+  !> remainder of A / B, with the sign of A (as the mod intrinsic)
+  !> @param[in] A -- array or scalar (real, double precision or integer)
+  !> @param[in] B -- array or scalar (real, double precision or integer)
+  !> @returns output which performs the function element wise
+  interface mod
+     module procedure array_mod
+     module procedure array_mod_s, array_lmod_s
+     module procedure array_mod_d, array_lmod_d
+     module procedure array_mod_i, array_lmod_i
+  end interface mod
+  !> @}
+
+  !> @{
+  !> modulo of A / B, with the sign of B (as the modulo intrinsic)
+  !> @param[in] A -- array or scalar (real, double precision or integer)
+  !> @param[in] B -- array or scalar (real, double precision or integer)
+  !> @returns output which performs the function element wise
+  interface modulo
+     module procedure array_modulo
+     module procedure array_modulo_s, array_lmodulo_s
+     module procedure array_modulo_d, array_lmodulo_d
+     module procedure array_modulo_i, array_lmodulo_i
+  end interface modulo
+  !> @}
+
+  !> @{
+  !> Pick elements from A where cond is true and from B elsewhere
+  !> @param[in] cond -- b8 array, usually the result of a comparison
+  !> @param[in] A -- array or scalar (real or double precision)
+  !> @param[in] B -- array or scalar (real or double precision)
+  !> @returns output of the same size as cond
+  interface select
+     module procedure array_select
+     module procedure array_select_s, array_lselect_s
+     module procedure array_select_d, array_lselect_d
+  end interface select
+  !> @}
+
+  !> @{
+  !> Limit the elements of an array to the range [lo, hi]
+  !> @param[in] A -- Should be type array
+  !> @param[in] lo -- Lower bound. Array, real or double precision
+  !> @param[in] hi -- Upper bound. Same type as lo
+  !> @returns output which performs the function element wise
+  interface clamp
+     module procedure array_clamp, array_clamp_s, array_clamp_d
+  end interface clamp
+  !> @}
+
   !> @}
   !> @}
 
@@ -987,6 +1554,36 @@ module arrayfire
      module procedure array_solve
   end interface solve
   !> @}
+
+  !> @{
+  !> Solve a double precision system using a single precision factorization
+  !> The LU factorization is done in f32 (c32 for complex input) and the solution
+  !> is refined with residuals computed in the input precision. If the relative
+  !> residual does not drop below tol within maxit corrections, the system is
+  !> solved again with a full precision LU. Single precision input and non square A
+  !> are solved directly with solve.
+  !> @param[out] X -- Contains the solution to the system of equations
+  !> @param[in]  A -- Co-efficient matrix (f64 or c64)
+  !> @param[in]  B -- Observations
+  !> @param[in]  tol -- Relative residual norm(B - A*X) / (norm(A) * norm(X)). Optional. Default: epsilon(1d0) * sqrt(N)
+  !> @param[in]  maxit -- Maximum number of refinement corrections. Optional. Default: 30
+  !> @param[out] iter -- Number of residual evaluations until convergence, so 1 means no correction
+  !> was needed (unlike LAPACK dsgesv, which counts corrections). 0 if A was solved directly,
+  !> negative if refinement did not converge and the full precision fallback was used. Optional.
+  !> @param[out] resid -- Relative residual of the returned solution, on every path. Optional.
+  !> @code
+  !! type(array) A, B, X0, X
+  !! integer :: iter
+  !! double precision :: resid
+  !! A  = randu(500, 500, ty=f64)
+  !! X0 = randu(500, 1, ty=f64)
+  !! B = matmul(A, X0)
+  !! X = solve_refined(A, B, iter=iter, resid=resid)
+  !! @endcode
+  interface solve_refined
+     module procedure array_solve_refined
+  end interface solve_refined
+  !> @}
   !> @}
 
   !> @defgroup linops Other Linear algebra operations: inverse, matrix power, norm, rank
@@ -1062,6 +1659,23 @@ module arrayfire
      module procedure array_product
   end interface product
   !> @}
+
+  !> @{
+  !> Prefix sum of elements in an array, along a given dimension
+  !> @param[in]  A -- Input matrix
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @param[in]  inclusive -- logical, .false. excludes the current element. Optional. Default: .true.
+  !> @returns R -- Prefix sum of the input, same size as the input
+  !> @code
+  !! type(array) A, S
+  !! A = constant(1, 5)
+  !! S = scan(A)                    ! 1, 2, 3, 4, 5
+  !! S = scan(A, inclusive=.false.) ! 0, 1, 2, 3, 4
+  !! @endcode
+  interface scan
+     module procedure array_scan
+  end interface scan
+  !> @}
   !> @}
 
   !> @defgroup minmax Minimum and Maximum
@@ -1072,6 +1686,7 @@ module arrayfire
   !! A  = randu(5,5)
   !! mx = max(A)        ! Get maximum of elements along columns (default). Same as max(A,1)
   !! mn = min(A, 2)     ! Get minimum of elements along rows
+  !! mx = max(A, 0.5)   ! Element wise maximum with a scalar (or another array)
   !! @endcode
   !! @{
 
@@ -1085,6 +1700,18 @@ module arrayfire
   end interface min
   !> @}
 
+  !> @{
+  !> Element wise minimum of two arrays, or of an array and a scalar
+  !> @param[in]  A -- array or scalar (real or double precision)
+  !> @param[in]  B -- array or scalar (real or double precision)
+  !> @returns R -- Element wise minimum. An integer B selects the reduction above instead
+  interface min
+     module procedure array_elmin
+     module procedure array_min_s, array_lmin_s
+     module procedure array_min_d, array_lmin_d
+  end interface min
+  !> @}
+
   !> @{
   !> Maximum of elements in an array, along a given dimension
   !> @param[in]  A -- Input matrix
@@ -1094,10 +1721,71 @@ module arrayfire
      module procedure array_max
   end interface max
   !> @}
-  !> @}
 
-  !> @defgroup anyall Test if any / all true
-  !> Test if any / all elements in the array are true
+  !> @{
+  !> Element wise maximum of two arrays, or of an array and a scalar
+  !> @param[in]  A -- array or scalar (real or double precision)
+  !> @param[in]  B -- array or scalar (real or double precision)
+  !> @returns R -- Element wise maximum. An integer B selects the reduction above instead
+  interface max
+     module procedure array_elmax
+     module procedure array_max_s, array_lmax_s
+     module procedure array_max_d, array_lmax_d
+  end interface max
+  !> @}
+
+  !> @{
+  !> Minimum of elements in an array and its location, along a given dimension
+  !> @param[out] val -- Minimum value of input
+  !> @param[out] loc -- 1-based index of the minimum along dim (integer array, usable with get / set)
+  !> @param[in]  A -- Input matrix
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @code
+  !! type(array) A, val, loc
+  !! A = randu(5,5)
+  !! call imin(val, loc, A)  ! Minimum of each column and its row index
+  !! @endcode
+  interface imin
+     module procedure array_imin
+  end interface imin
+  !> @}
+
+  !> @{
+  !> Maximum of elements in an array and its location, along a given dimension
+  !> @param[out] val -- Maximum value of input
+  !> @param[out] loc -- 1-based index of the maximum along dim (integer array, usable with get / set)
+  !> @param[in]  A -- Input matrix
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @code
+  !! type(array) A, val, loc
+  !! A = randu(5,5)
+  !! call imax(val, loc, A, 2)  ! Maximum of each row and its column index
+  !! @endcode
+  interface imax
+     module procedure array_imax
+  end interface imax
+  !> @}
+
+  !> @{
+  !> Minimum and maximum of elements in an array, along a given dimension.
+  !> Same cost as calling min and max.
+  !> @param[out] mn -- Minimum value of input
+  !> @param[out] mx -- Maximum value of input
+  !> @param[in]  A -- Input matrix
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @code
+  !! type(array) A, mn, mx
+  !! A = randu(5,5)
+  !! call minmax(mn, mx, A)
+  !! @endcode
+  interface minmax
+     module procedure array_minmax
+  end interface minmax
+  !> @}
+  !> @}
+
+  !> @defgroup anyall Test if any / all true
+  !> Test if any / all elements in the array are true
   !> @code
   !! type(array) A, an, al
   !! ! Generate random system
@@ -1169,9 +1857,1553 @@ module arrayfire
   end interface var
   !> @}
 
+  !> @{
+  !> Mean and variance of elements in an array computed in a single pass, along a given dimension
+  !> @param[out] mu -- Mean value of input
+  !> @param[out] s2 -- Variance of input (same normalization as var)
+  !> @param[in]  A -- Input matrix
+  !> @param[in]  dim -- Integer (dimension of the operation). Optional. Default: 1
+  !> @code
+  !! type(array) A, mu, s2
+  !! A = randu(5,5)
+  !! call mean_var(mu, s2, A)
+  !! @endcode
+  interface mean_var
+     module procedure array_mean_var
+  end interface mean_var
+  !> @}
+
+  !> @}
+  !> @}
+
+  !> @defgroup signal Signal Processing
+  !> Routines for spectral analysis and filtering
+  !> @{
+
+  !> @defgroup fft Fast Fourier Transforms
+  !> Transforms are performed along the leading 1, 2 or 3 dimensions and batched
+  !> along the remaining ones. Plans are cached per shape, so repeated transforms
+  !> of the same size skip plan setup.
+  !> @code
+  !! type(array) A, F, B, H, C
+  !! A = randu(64, 100)        ! 100 signals of length 64
+  !! F = fft(A)                ! Complex spectrum of each column
+  !! B = real(ifft(F))         ! Back to A
+  !! H = fftr2c(A, 1)          ! Half spectrum of each column, size 33 x 100
+  !! C = fftc2r(H, 1)          ! Back to A
+  !! @endcode
+  !! @{
+
+  !> @{
+  !> Fast fourier transform along the first dimension
+  !> @param[in]  A -- Input array, real or complex
+  !> @returns R -- Complex spectrum of the same size as A
+  interface fft
+     module procedure array_fft
+  end interface fft
+  !> @}
+
+  !> @{
+  !> Inverse fast fourier transform along the first dimension (normalized)
+  !> @param[in]  A -- Input array, real or complex
+  !> @returns R -- Complex signal of the same size as A
+  interface ifft
+     module procedure array_ifft
+  end interface ifft
+  !> @}
+
+  !> @{
+  !> Fast fourier transform along the first two dimensions
+  !> @param[in]  A -- Input array, real or complex
+  !> @returns R -- Complex spectrum of the same size as A
+  interface fft2
+     module procedure array_fft2
+  end interface fft2
+  !> @}
+
+  !> @{
+  !> Inverse fast fourier transform along the first two dimensions (normalized)
+  !> @param[in]  A -- Input array, real or complex
+  !> @returns R -- Complex signal of the same size as A
+  interface ifft2
+     module procedure array_ifft2
+  end interface ifft2
+  !> @}
+
+  !> @{
+  !> Fast fourier transform along the first three dimensions
+  !> @param[in]  A -- Input array, real or complex
+  !> @returns R -- Complex spectrum of the same size as A
+  interface fft3
+     module procedure array_fft3
+  end interface fft3
+  !> @}
+
+  !> @{
+  !> Inverse fast fourier transform along the first three dimensions (normalized)
+  !> @param[in]  A -- Input array, real or complex
+  !> @returns R -- Complex signal of the same size as A
+  interface ifft3
+     module procedure array_ifft3
+  end interface ifft3
+  !> @}
+
+  !> @{
+  !> Real to complex fast fourier transform
+  !> @param[in]  A -- Real input array
+  !> @param[in]  rank -- Number of leading dimensions to transform (1, 2 or 3)
+  !> @returns R -- Non redundant half of the spectrum, first dimension is N/2 + 1
+  interface fftr2c
+     module procedure array_fftr2c
+  end interface fftr2c
+  !> @}
+
+  !> @{
+  !> Complex to real inverse fast fourier transform (normalized)
+  !> @param[in]  A -- Half spectrum as returned by fftr2c
+  !> @param[in]  rank -- Number of leading dimensions to transform (1, 2 or 3)
+  !> @param[in]  is_odd -- logical, true if the original first dimension was odd. Optional. Default: .false.
+  !> @returns R -- Real signal
+  interface fftc2r
+     module procedure array_fftc2r
+  end interface fftc2r
+  !> @}
+
+  !> @{
+  !> Number of fft plans kept in the cache
+  !> @param[in]  n -- Maximum number of cached plans
+  !> @code
+  !! call fft_plan_cache(10)
+  !! @endcode
+  interface fft_plan_cache
+     module procedure fft_plan_cache_
+  end interface fft_plan_cache
+  !> @}
+  !> @}
+
+  !> @defgroup conv Convolutions
+  !> The convolution is done directly or through FFTs, depending on the sizes
+  !> of the signal and the filter. Extra dimensions of the signal are batched.
+  !> @code
+  !! type(array) A, K, B
+  !! A = randu(128, 128)
+  !! K = constant(1, 5, 5) / 25.0
+  !! B = convolve2(A, K)           ! Same size as A
+  !! B = convolve2(A, K, .true.)   ! Expanded, size 132 x 132
+  !! @endcode
+  !! @{
+
+  !> @{
+  !> One dimensional convolution
+  !> @param[in]  A -- Input signal
+  !> @param[in]  F -- Filter
+  !> @param[in]  expand -- logical, return the full convolution. Optional. Default: .false.
+  !> @returns R -- Filtered signal
+  interface convolve1
+     module procedure array_convolve1
+  end interface convolve1
+  !> @}
+
+  !> @{
+  !> Two dimensional convolution
+  !> @param[in]  A -- Input signal
+  !> @param[in]  F -- Filter
+  !> @param[in]  expand -- logical, return the full convolution. Optional. Default: .false.
+  !> @returns R -- Filtered signal
+  interface convolve2
+     module procedure array_convolve2
+  end interface convolve2
+  !> @}
+
+  !> @{
+  !> Three dimensional convolution
+  !> @param[in]  A -- Input signal
+  !> @param[in]  F -- Filter
+  !> @param[in]  expand -- logical, return the full convolution. Optional. Default: .false.
+  !> @returns R -- Filtered signal
+  interface convolve3
+     module procedure array_convolve3
+  end interface convolve3
+  !> @}
   !> @}
   !> @}
 
+  ! Entry points of the C++ wrapper (fortran_wrapper.cpp). Array inputs and
+  ! scalars are passed by value, new arrays are returned through the handle.
+  interface
+     subroutine af_backend_set(b, err) bind(C)
+       import :: C_int
+       integer(C_int), value :: b
+       integer(C_int) :: err
+     end subroutine af_backend_set
+     subroutine af_backend_get(b) bind(C)
+       import :: C_int
+       integer(C_int) :: b
+     end subroutine af_backend_get
+     subroutine af_backend_count(n) bind(C)
+       import :: C_int
+       integer(C_int) :: n
+     end subroutine af_backend_count
+     subroutine af_backend_available(b, avail) bind(C)
+       import :: C_int
+       integer(C_int), value :: b
+       integer(C_int) :: avail
+     end subroutine af_backend_available
+
+     subroutine af_device_info() bind(C)
+     end subroutine af_device_info
+     subroutine af_device_get(n) bind(C)
+       import :: C_int
+       integer(C_int) :: n
+     end subroutine af_device_get
+     subroutine af_device_set(n) bind(C)
+       import :: C_int
+       integer(C_int), value :: n
+     end subroutine af_device_set
+     subroutine af_device_count(n) bind(C)
+       import :: C_int
+       integer(C_int) :: n
+     end subroutine af_device_count
+     subroutine af_device_eval(arr) bind(C)
+       import :: C_ptr
+       type(C_ptr), value :: arr
+     end subroutine af_device_eval
+     subroutine af_device_sync() bind(C)
+     end subroutine af_device_sync
+     subroutine af_timer_start() bind(C)
+     end subroutine af_timer_start
+     subroutine af_timer_stop(elapsed) bind(C)
+       import :: C_double
+       real(C_double) :: elapsed
+     end subroutine af_timer_stop
+
+     subroutine af_arr_device_s(ptr, a, shape, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: ptr
+       real(C_float), intent(in) :: a(*)
+       integer(C_int), intent(in) :: shape(4)
+       integer(C_int) :: err
+     end subroutine af_arr_device_s
+     subroutine af_arr_device_d(ptr, a, shape, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: ptr
+       real(C_double), intent(in) :: a(*)
+       integer(C_int), intent(in) :: shape(4)
+       integer(C_int) :: err
+     end subroutine af_arr_device_d
+     subroutine af_arr_device_c(ptr, a, shape, err) bind(C)
+       import :: C_ptr, C_float_complex, C_int
+       type(C_ptr) :: ptr
+       complex(C_float_complex), intent(in) :: a(*)
+       integer(C_int), intent(in) :: shape(4)
+       integer(C_int) :: err
+     end subroutine af_arr_device_c
+     subroutine af_arr_device_z(ptr, a, shape, err) bind(C)
+       import :: C_ptr, C_double_complex, C_int
+       type(C_ptr) :: ptr
+       complex(C_double_complex), intent(in) :: a(*)
+       integer(C_int), intent(in) :: shape(4)
+       integer(C_int) :: err
+     end subroutine af_arr_device_z
+     subroutine af_arr_host_s(a, ptr, dim, err) bind(C)
+       import :: C_float, C_ptr, C_int
+       real(C_float) :: a(*)
+       type(C_ptr), value :: ptr
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_host_s
+     subroutine af_arr_host_d(a, ptr, dim, err) bind(C)
+       import :: C_double, C_ptr, C_int
+       real(C_double) :: a(*)
+       type(C_ptr), value :: ptr
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_host_d
+     subroutine af_arr_host_c(a, ptr, dim, err) bind(C)
+       import :: C_float_complex, C_ptr, C_int
+       complex(C_float_complex) :: a(*)
+       type(C_ptr), value :: ptr
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_host_c
+     subroutine af_arr_host_z(a, ptr, dim, err) bind(C)
+       import :: C_double_complex, C_ptr, C_int
+       complex(C_double_complex) :: a(*)
+       type(C_ptr), value :: ptr
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_host_z
+     subroutine af_arr_copy(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_copy
+
+     subroutine af_arr_randu(ptr, x, fty, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: ptr
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int), value :: fty
+       integer(C_int) :: err
+     end subroutine af_arr_randu
+     subroutine af_arr_randn(ptr, x, fty, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: ptr
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int), value :: fty
+       integer(C_int) :: err
+     end subroutine af_arr_randn
+     subroutine af_arr_identity(ptr, x, fty, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: ptr
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int), value :: fty
+       integer(C_int) :: err
+     end subroutine af_arr_identity
+     subroutine af_arr_constant(ptr, val, x, fty, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: ptr
+       integer(C_int), value :: val, fty
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int) :: err
+     end subroutine af_arr_constant
+
+     subroutine af_arr_scplus_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scplus_s
+     subroutine af_arr_scplus_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scplus_d
+     subroutine af_arr_scplus_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scplus_i
+     subroutine af_arr_scminus_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scminus_s
+     subroutine af_arr_scminus_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scminus_d
+     subroutine af_arr_scminus_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scminus_i
+     subroutine af_arr_sctimes_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_sctimes_s
+     subroutine af_arr_sctimes_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_sctimes_d
+     subroutine af_arr_sctimes_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_sctimes_i
+     subroutine af_arr_scdiv_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scdiv_s
+     subroutine af_arr_scdiv_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scdiv_d
+     subroutine af_arr_scdiv_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scdiv_i
+     subroutine af_arr_scpow_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scpow_s
+     subroutine af_arr_scpow_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scpow_d
+     subroutine af_arr_scpow_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scpow_i
+     subroutine af_arr_scle_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scle_s
+     subroutine af_arr_scle_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scle_d
+     subroutine af_arr_scle_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scle_i
+     subroutine af_arr_sclt_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_sclt_s
+     subroutine af_arr_sclt_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_sclt_d
+     subroutine af_arr_sclt_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_sclt_i
+     subroutine af_arr_scge_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scge_s
+     subroutine af_arr_scge_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scge_d
+     subroutine af_arr_scge_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scge_i
+     subroutine af_arr_scgt_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scgt_s
+     subroutine af_arr_scgt_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scgt_d
+     subroutine af_arr_scgt_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scgt_i
+     subroutine af_arr_sceq_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_sceq_s
+     subroutine af_arr_sceq_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_sceq_d
+     subroutine af_arr_sceq_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_sceq_i
+     subroutine af_arr_scne_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scne_s
+     subroutine af_arr_scne_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scne_d
+     subroutine af_arr_scne_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scne_i
+     subroutine af_arr_scatan2_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scatan2_s
+     subroutine af_arr_scatan2_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scatan2_d
+     subroutine af_arr_scatan2_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scatan2_i
+     subroutine af_arr_schypot_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_schypot_s
+     subroutine af_arr_schypot_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_schypot_d
+     subroutine af_arr_schypot_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_schypot_i
+     subroutine af_arr_scmod_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmod_s
+     subroutine af_arr_scmod_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmod_d
+     subroutine af_arr_scmod_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmod_i
+     subroutine af_arr_scmodulo_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmodulo_s
+     subroutine af_arr_scmodulo_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmodulo_d
+     subroutine af_arr_scmodulo_i(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: val, rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmodulo_i
+     subroutine af_arr_scmin_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmin_s
+     subroutine af_arr_scmin_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmin_d
+     subroutine af_arr_scmax_s(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmax_s
+     subroutine af_arr_scmax_d(dst, src, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scmax_d
+
+     subroutine af_arr_elplus(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elplus
+     subroutine af_arr_elminus(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elminus
+     subroutine af_arr_eltimes(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_eltimes
+     subroutine af_arr_eldiv(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_eldiv
+     subroutine af_arr_elpow(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elpow
+     subroutine af_arr_elle(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elle
+     subroutine af_arr_ellt(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_ellt
+     subroutine af_arr_elge(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elge
+     subroutine af_arr_elgt(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elgt
+     subroutine af_arr_eleq(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_eleq
+     subroutine af_arr_elne(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elne
+     subroutine af_arr_eland(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_eland
+     subroutine af_arr_elor(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elor
+     subroutine af_arr_elatan2(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elatan2
+     subroutine af_arr_elhypot(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elhypot
+     subroutine af_arr_elmin(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elmin
+     subroutine af_arr_elmax(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elmax
+     subroutine af_arr_elmod(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elmod
+     subroutine af_arr_elmodulo(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_elmodulo
+
+     subroutine af_arr_negate(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_negate
+     subroutine af_arr_not(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_not
+     subroutine af_arr_sin(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_sin
+     subroutine af_arr_cos(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_cos
+     subroutine af_arr_tan(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_tan
+     subroutine af_arr_asin(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_asin
+     subroutine af_arr_acos(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_acos
+     subroutine af_arr_atan(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_atan
+     subroutine af_arr_sinh(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_sinh
+     subroutine af_arr_cosh(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_cosh
+     subroutine af_arr_tanh(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_tanh
+     subroutine af_arr_asinh(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_asinh
+     subroutine af_arr_acosh(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_acosh
+     subroutine af_arr_atanh(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_atanh
+     subroutine af_arr_log(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_log
+     subroutine af_arr_log10(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_log10
+     subroutine af_arr_log2(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_log2
+     subroutine af_arr_log1p(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_log1p
+     subroutine af_arr_abs(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_abs
+     subroutine af_arr_exp(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_exp
+     subroutine af_arr_expm1(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_expm1
+     subroutine af_arr_sqrt(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_sqrt
+     subroutine af_arr_cbrt(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_cbrt
+     subroutine af_arr_erf(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_erf
+     subroutine af_arr_erfc(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_erfc
+     subroutine af_arr_tgamma(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_tgamma
+     subroutine af_arr_lgamma(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_lgamma
+     subroutine af_arr_floor(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_floor
+     subroutine af_arr_ceil(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_ceil
+     subroutine af_arr_round(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_round
+     subroutine af_arr_trunc(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_trunc
+     subroutine af_arr_iszero(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_iszero
+     subroutine af_arr_sort(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_sort
+     subroutine af_arr_upper(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_upper
+     subroutine af_arr_lower(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_lower
+     subroutine af_arr_diag(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_diag
+     subroutine af_arr_real(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_real
+     subroutine af_arr_imag(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_imag
+     subroutine af_arr_complex(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_complex
+     subroutine af_arr_conjg(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_conjg
+     subroutine af_arr_sign(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_sign
+     subroutine af_arr_isnan(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_isnan
+     subroutine af_arr_isinf(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_isinf
+
+     subroutine af_arr_select(dst, cond, a, b, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: cond, a, b
+       integer(C_int) :: err
+     end subroutine af_arr_select
+     subroutine af_arr_scselect_s(dst, cond, a, val, rev, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: cond, a
+       real(C_float), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scselect_s
+     subroutine af_arr_scselect_d(dst, cond, a, val, rev, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: cond, a
+       real(C_double), value :: val
+       integer(C_int), value :: rev
+       integer(C_int) :: err
+     end subroutine af_arr_scselect_d
+     subroutine af_arr_clamp(dst, src, lo, hi, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src, lo, hi
+       integer(C_int) :: err
+     end subroutine af_arr_clamp
+     subroutine af_arr_scclamp_s(dst, src, lo, hi, err) bind(C)
+       import :: C_ptr, C_float, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: lo, hi
+       integer(C_int) :: err
+     end subroutine af_arr_scclamp_s
+     subroutine af_arr_scclamp_d(dst, src, lo, hi, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       real(C_double), value :: lo, hi
+       integer(C_int) :: err
+     end subroutine af_arr_scclamp_d
+
+     subroutine af_arr_sum(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_sum
+     subroutine af_arr_product(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_product
+     subroutine af_arr_min(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_min
+     subroutine af_arr_max(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_max
+     subroutine af_arr_mean(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_mean
+     subroutine af_arr_stdev(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_stdev
+     subroutine af_arr_var(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_var
+     subroutine af_arr_anytrue(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_anytrue
+     subroutine af_arr_alltrue(dst, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_alltrue
+     subroutine af_arr_imin(val, idx, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: val, idx
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_imin
+     subroutine af_arr_imax(val, idx, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: val, idx
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_imax
+     subroutine af_arr_minmax(mn, mx, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: mn, mx
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_minmax
+     subroutine af_arr_mean_var(mu, s2, src, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: mu, s2
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_mean_var
+
+     subroutine af_arr_sort_index(out, idx, src, dim, asc, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: out, idx
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim, asc
+       integer(C_int) :: err
+     end subroutine af_arr_sort_index
+     subroutine af_arr_sort_by_key(okeys, ovals, keys, vals, dim, asc, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: okeys, ovals
+       type(C_ptr), value :: keys, vals
+       integer(C_int), value :: dim, asc
+       integer(C_int) :: err
+     end subroutine af_arr_sort_by_key
+     subroutine af_arr_topk(val, idx, src, k, largest, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: val, idx
+       type(C_ptr), value :: src
+       integer(C_int), value :: k, largest
+       integer(C_int) :: err
+     end subroutine af_arr_topk
+     subroutine af_arr_where(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_where
+     subroutine af_arr_scan(dst, src, dim, inclusive, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: dim, inclusive
+       integer(C_int) :: err
+     end subroutine af_arr_scan
+
+     subroutine af_fft_plan_cache(n) bind(C)
+       import :: C_int
+       integer(C_int), value :: n
+     end subroutine af_fft_plan_cache
+     subroutine af_arr_fft(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_fft
+     subroutine af_arr_ifft(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_ifft
+     subroutine af_arr_fft2(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_fft2
+     subroutine af_arr_ifft2(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_ifft2
+     subroutine af_arr_fft3(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_fft3
+     subroutine af_arr_ifft3(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_ifft3
+     subroutine af_arr_fftr2c(dst, src, rank, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: rank
+       integer(C_int) :: err
+     end subroutine af_arr_fftr2c
+     subroutine af_arr_fftc2r(dst, src, rank, odd, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), value :: rank, odd
+       integer(C_int) :: err
+     end subroutine af_arr_fftc2r
+     subroutine af_arr_convolve1(dst, src, flt, expand, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src, flt
+       integer(C_int), value :: expand
+       integer(C_int) :: err
+     end subroutine af_arr_convolve1
+     subroutine af_arr_convolve2(dst, src, flt, expand, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src, flt
+       integer(C_int), value :: expand
+       integer(C_int) :: err
+     end subroutine af_arr_convolve2
+     subroutine af_arr_convolve3(dst, src, flt, expand, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src, flt
+       integer(C_int), value :: expand
+       integer(C_int) :: err
+     end subroutine af_arr_convolve3
+
+     subroutine af_arr_moddims(dst, src, x, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int) :: err
+     end subroutine af_arr_moddims
+     subroutine af_arr_tile(dst, src, x, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int) :: err
+     end subroutine af_arr_tile
+     subroutine af_arr_shift(dst, src, x, boundary, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), intent(in) :: x(4)
+       integer(C_int), value :: boundary
+       integer(C_int) :: err
+     end subroutine af_arr_shift
+     subroutine af_arr_stencil(dst, src, offs, ndim, w, npts, boundary, err) bind(C)
+       import :: C_ptr, C_int, C_double
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), intent(in) :: offs(*)
+       integer(C_int), value :: ndim, npts, boundary
+       real(C_double), intent(in) :: w(*)
+       integer(C_int) :: err
+     end subroutine af_arr_stencil
+     subroutine af_arr_t(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_t
+     subroutine af_arr_h(dst, src, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_h
+     subroutine af_arr_reorder(dst, src, shape, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: src
+       integer(C_int), intent(in) :: shape(4)
+       integer(C_int) :: err
+     end subroutine af_arr_reorder
+     subroutine af_arr_complex2(dst, re, im, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: re, im
+       integer(C_int) :: err
+     end subroutine af_arr_complex2
+
+     subroutine af_arr_norm(dst, src, err) bind(C)
+       import :: C_double, C_ptr, C_int
+       real(C_double) :: dst
+       type(C_ptr), value :: src
+       integer(C_int) :: err
+     end subroutine af_arr_norm
+     subroutine af_arr_pnorm(dst, src, p, err) bind(C)
+       import :: C_double, C_ptr, C_float, C_int
+       real(C_double) :: dst
+       type(C_ptr), value :: src
+       real(C_float), value :: p
+       integer(C_int) :: err
+     end subroutine af_arr_pnorm
+     subroutine af_arr_matmul(dst, lhs, rhs, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: dst
+       type(C_ptr), value :: lhs, rhs
+       integer(C_int) :: err
+     end subroutine af_arr_matmul
+     subroutine af_arr_lu(l, u, p, in, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: l, u, p
+       type(C_ptr), value :: in
+       integer(C_int) :: err
+     end subroutine af_arr_lu
+     subroutine af_arr_lu_inplace(in, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: in
+       integer(C_int) :: err
+     end subroutine af_arr_lu_inplace
+     subroutine af_arr_qr(q, r, in, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: q, r
+       type(C_ptr), value :: in
+       integer(C_int) :: err
+     end subroutine af_arr_qr
+     subroutine af_arr_cholesky(r, in, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: r
+       type(C_ptr), value :: in
+       integer(C_int) :: err
+     end subroutine af_arr_cholesky
+     subroutine af_arr_cholesky_inplace(r, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: r
+       integer(C_int) :: err
+     end subroutine af_arr_cholesky_inplace
+     subroutine af_arr_singular(s, u, v, in, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: s, u, v
+       type(C_ptr), value :: in
+       integer(C_int) :: err
+     end subroutine af_arr_singular
+     subroutine af_arr_inverse(r, in, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: r
+       type(C_ptr), value :: in
+       integer(C_int) :: err
+     end subroutine af_arr_inverse
+     subroutine af_arr_solve(x, a, b, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: x
+       type(C_ptr), value :: a, b
+       integer(C_int) :: err
+     end subroutine af_arr_solve
+     subroutine af_arr_solve_refined(x, a, b, tol, maxit, iter, res, err) bind(C)
+       import :: C_ptr, C_double, C_int
+       type(C_ptr) :: x
+       type(C_ptr), value :: a, b
+       real(C_double), value :: tol
+       integer(C_int), value :: maxit
+       integer(C_int) :: iter, err
+       real(C_double) :: res
+     end subroutine af_arr_solve_refined
+
+     subroutine af_arr_get(out, in, d0, d1, d2, d3, dims, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: out
+       type(C_ptr), value :: in, d0, d1
+       integer(C_int), intent(in) :: d2(3), d3(3)
+       integer(C_int), value :: dims
+       integer(C_int) :: err
+     end subroutine af_arr_get
+     subroutine af_arr_get2(out, in, d0, d1, d2, dims, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: out
+       type(C_ptr), value :: in, d0
+       integer(C_int), intent(in) :: d1(3), d2(3)
+       integer(C_int), value :: dims
+       integer(C_int) :: err
+     end subroutine af_arr_get2
+     subroutine af_arr_get_seq(out, in, d0, d1, d2, d3, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: out
+       type(C_ptr), value :: in
+       integer(C_int), intent(in) :: d0(3), d1(3), d2(3), d3(3)
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_get_seq
+     subroutine af_arr_set(out, in, d0, d1, d2, d3, dims, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: out, in, d0, d1
+       integer(C_int), intent(in) :: d2(3), d3(3)
+       integer(C_int), value :: dims
+       integer(C_int) :: err
+     end subroutine af_arr_set
+     subroutine af_arr_set2(out, in, d0, d1, d2, dims, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: out, in, d0
+       integer(C_int), intent(in) :: d1(3), d2(3)
+       integer(C_int), value :: dims
+       integer(C_int) :: err
+     end subroutine af_arr_set2
+     subroutine af_arr_set_seq(out, in, d0, d1, d2, d3, dim, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: out, in
+       integer(C_int), intent(in) :: d0(3), d1(3), d2(3), d3(3)
+       integer(C_int), value :: dim
+       integer(C_int) :: err
+     end subroutine af_arr_set_seq
+     subroutine af_idx_seq(out, first, last, step, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: out
+       integer(C_int), value :: first, last, step
+       integer(C_int) :: err
+     end subroutine af_idx_seq
+     subroutine af_idx_vec(out, indices, numel, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: out
+       integer(C_int), intent(in) :: indices(*)
+       integer(C_int), value :: numel
+       integer(C_int) :: err
+     end subroutine af_idx_vec
+     subroutine af_arr_join(dim, out, in1, in2, err) bind(C)
+       import :: C_int, C_ptr
+       integer(C_int), value :: dim
+       type(C_ptr) :: out
+       type(C_ptr), value :: in1, in2
+       integer(C_int) :: err
+     end subroutine af_arr_join
+
+     subroutine af_graph_begin(g, inputs, n, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr) :: g
+       type(C_ptr), intent(in) :: inputs(*)
+       integer(C_int), value :: n
+       integer(C_int) :: err
+     end subroutine af_graph_begin
+     subroutine af_graph_end(g, outputs, n, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: g
+       type(C_ptr), intent(in) :: outputs(*)
+       integer(C_int), value :: n
+       integer(C_int) :: err
+     end subroutine af_graph_end
+     subroutine af_graph_run(g, inputs, nin, outputs, nout, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: g
+       type(C_ptr), intent(in) :: inputs(*)
+       integer(C_int), value :: nin, nout
+       type(C_ptr) :: outputs(*)
+       integer(C_int) :: err
+     end subroutine af_graph_run
+     subroutine af_graph_free(g) bind(C)
+       import :: C_ptr
+       type(C_ptr) :: g
+     end subroutine af_graph_free
+
+     subroutine init_post(in, shape, rank) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: in
+       integer(C_int) :: shape(4), rank
+     end subroutine init_post
+     subroutine af_arr_print(ptr, err) bind(C)
+       import :: C_ptr, C_int
+       type(C_ptr), value :: ptr
+       integer(C_int) :: err
+     end subroutine af_arr_print
+  end interface
+
 contains
 
   function elements(A) result(num)
@@ -1308,6 +3540,9 @@ contains
     integer, dimension(3) :: idx3
     integer, dimension(3) :: idx4
 
+    idx2 = C_NULL_ptr
+    idx3 = 0
+    idx4 = 0
     idx1 = d1%ptr
     dims = 1
 
@@ -1409,6 +3644,9 @@ contains
     integer, dimension(3) :: idx4
     integer :: dims
 
+    idx2 = C_NULL_ptr
+    idx3 = 0
+    idx4 = 0
     idx1 = d1%ptr
     dims = 1
 
@@ -1949,6 +4187,58 @@ contains
   end function array_join
 
 
+  !> Shift an array
+  function array_shift(A, s1, s2, s3, s4, boundary) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    integer, intent(in) :: s1
+    integer, intent(in), optional :: s2, s3, s4, boundary
+    integer :: x(4)
+    integer :: bb
+
+    x = [s1, 0, 0, 0]
+    bb = af_periodic
+    if (present(s2)) x(2) = s2
+    if (present(s3)) x(3) = s3
+    if (present(s4)) x(4) = s4
+    if (present(boundary)) bb = boundary
+
+    call init_eq(R, A)
+    call af_arr_shift(R%ptr, A%ptr, x, bb, err)
+  end function array_shift
+
+  !> Apply a stencil with single precision weights
+  function array_stencil_s(A, offsets, weights, boundary) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: offsets(:,:)
+    real, intent(in) :: weights(:)
+    integer, intent(in), optional :: boundary
+    type(array) :: R
+    R = array_stencil_d(A, offsets, dble(weights), boundary)
+  end function array_stencil_s
+
+  !> Apply a stencil with double precision weights
+  function array_stencil_d(A, offsets, weights, boundary) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: offsets(:,:)
+    double precision, intent(in) :: weights(:)
+    integer, intent(in), optional :: boundary
+    type(array) :: R
+    integer :: bb
+
+    bb = af_periodic
+    if (present(boundary)) bb = boundary
+
+    if (size(offsets, 2) /= size(weights)) then
+       write(*,*) "stencil: offsets and weights have different number of points"
+       stop
+    end if
+
+    call init_eq(R, A)
+    call af_arr_stencil(R%ptr, A%ptr, offsets, size(offsets, 1), &
+                        weights, size(weights), bb, err)
+  end function array_stencil_d
+
   !> Generate  uniformly distributed random matrix
   function array_randu(x1, x2, x3, x4, ty) result(R)
     type(array) :: R
@@ -2101,7 +4391,7 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scplus(R%ptr, A%ptr, B, err)
+    call af_arr_scplus_d(R%ptr, A%ptr, B, 0, err)
   end function array_plus_d
 
   !> Add array to scalar
@@ -2109,7 +4399,8 @@ contains
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A + B
+    call init_eq(R, A)
+    call af_arr_scplus_d(R%ptr, A%ptr, B, 1, err)
   end function array_lplus_d
 
   !> Add scalar to array
@@ -2117,7 +4408,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A + dble(B)
+    call init_eq(R, A)
+    call af_arr_scplus_s(R%ptr, A%ptr, B, 0, err)
   end function array_plus_s
 
   !> Add array to scalar
@@ -2125,7 +4417,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A + dble(B)
+    call init_eq(R, A)
+    call af_arr_scplus_s(R%ptr, A%ptr, B, 1, err)
   end function array_lplus_s
 
   !> Add scalar to array
@@ -2133,7 +4426,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A + dble(B)
+    call init_eq(R, A)
+    call af_arr_scplus_i(R%ptr, A%ptr, B, 0, err)
   end function array_plus_i
 
   !> Add array to scalar
@@ -2141,7 +4435,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A + dble(B)
+    call init_eq(R, A)
+    call af_arr_scplus_i(R%ptr, A%ptr, B, 1, err)
   end function array_lplus_i
 
   !> Add scalar to array
@@ -2150,7 +4445,7 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scminus(R%ptr, A%ptr, B, err)
+    call af_arr_scminus_d(R%ptr, A%ptr, B, 0, err)
   end function array_minus_d
 
   !> Add array to scalar
@@ -2158,7 +4453,8 @@ contains
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A - B
+    call init_eq(R, A)
+    call af_arr_scminus_d(R%ptr, A%ptr, B, 1, err)
   end function array_lminus_d
 
   !> Add scalar to array
@@ -2166,7 +4462,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A - dble(B)
+    call init_eq(R, A)
+    call af_arr_scminus_s(R%ptr, A%ptr, B, 0, err)
   end function array_minus_s
 
   !> Add array to scalar
@@ -2174,7 +4471,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A - dble(B)
+    call init_eq(R, A)
+    call af_arr_scminus_s(R%ptr, A%ptr, B, 1, err)
   end function array_lminus_s
 
   !> Add scalar to array
@@ -2182,7 +4480,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A - dble(B)
+    call init_eq(R, A)
+    call af_arr_scminus_i(R%ptr, A%ptr, B, 0, err)
   end function array_minus_i
 
   !> Add array to scalar
@@ -2190,7 +4489,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A - dble(B)
+    call init_eq(R, A)
+    call af_arr_scminus_i(R%ptr, A%ptr, B, 1, err)
   end function array_lminus_i
 
   !> Add scalar to array
@@ -2199,7 +4499,7 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_sctimes(R%ptr, A%ptr, B, err)
+    call af_arr_sctimes_d(R%ptr, A%ptr, B, 0, err)
   end function array_times_d
 
   !> Add array to scalar
@@ -2207,7 +4507,8 @@ contains
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A * B
+    call init_eq(R, A)
+    call af_arr_sctimes_d(R%ptr, A%ptr, B, 1, err)
   end function array_ltimes_d
 
   !> Add scalar to array
@@ -2215,7 +4516,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A * dble(B)
+    call init_eq(R, A)
+    call af_arr_sctimes_s(R%ptr, A%ptr, B, 0, err)
   end function array_times_s
 
   !> Add array to scalar
@@ -2223,7 +4525,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A * dble(B)
+    call init_eq(R, A)
+    call af_arr_sctimes_s(R%ptr, A%ptr, B, 1, err)
   end function array_ltimes_s
 
   !> Add scalar to array
@@ -2231,7 +4534,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A * dble(B)
+    call init_eq(R, A)
+    call af_arr_sctimes_i(R%ptr, A%ptr, B, 0, err)
   end function array_times_i
 
   !> Add array to scalar
@@ -2239,7 +4543,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A * dble(B)
+    call init_eq(R, A)
+    call af_arr_sctimes_i(R%ptr, A%ptr, B, 1, err)
   end function array_ltimes_i
 
   !> Add scalar to array
@@ -2248,7 +4553,7 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scdiv(R%ptr, A%ptr, B, err)
+    call af_arr_scdiv_d(R%ptr, A%ptr, B, 0, err)
   end function array_div_d
 
   !> Add array to scalar
@@ -2256,7 +4561,8 @@ contains
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A / B
+    call init_eq(R, A)
+    call af_arr_scdiv_d(R%ptr, A%ptr, B, 1, err)
   end function array_ldiv_d
 
   !> Add scalar to array
@@ -2264,7 +4570,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A / dble(B)
+    call init_eq(R, A)
+    call af_arr_scdiv_s(R%ptr, A%ptr, B, 0, err)
   end function array_div_s
 
   !> Add array to scalar
@@ -2272,7 +4579,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A / dble(B)
+    call init_eq(R, A)
+    call af_arr_scdiv_s(R%ptr, A%ptr, B, 1, err)
   end function array_ldiv_s
 
   !> Add scalar to array
@@ -2280,7 +4588,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A / dble(B)
+    call init_eq(R, A)
+    call af_arr_scdiv_i(R%ptr, A%ptr, B, 0, err)
   end function array_div_i
 
   !> Add array to scalar
@@ -2288,7 +4597,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A / dble(B)
+    call init_eq(R, A)
+    call af_arr_scdiv_i(R%ptr, A%ptr, B, 1, err)
   end function array_ldiv_i
 
   !> Element wise power with scalar exponent
@@ -2297,7 +4607,7 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scpow(R%ptr, A%ptr, B, err)
+    call af_arr_scpow_d(R%ptr, A%ptr, B, 0, err)
   end function array_pow_d
 
   !> Element wise power with scalar exponent
@@ -2305,7 +4615,8 @@ contains
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A ** dble(B)
+    call init_eq(R, A)
+    call af_arr_scpow_s(R%ptr, A%ptr, B, 0, err)
   end function array_pow_s
 
   !> Element wise power with scalar exponent
@@ -2313,7 +4624,8 @@ contains
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A ** dble(B)
+    call init_eq(R, A)
+    call af_arr_scpow_i(R%ptr, A%ptr, B, 0, err)
   end function array_pow_i
 
   function array_gt(A, B) result(R)
@@ -2369,42 +4681,47 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scgt(R%ptr, A%ptr, B, err)
+    call af_arr_scgt_d(R%ptr, A%ptr, B, 0, err)
   end function array_gt_d
 
   function array_lgt_d(B, A) result(R)
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A < B
+    call init_eq(R, A)
+    call af_arr_scgt_d(R%ptr, A%ptr, B, 1, err)
   end function array_lgt_d
 
   function array_gt_s(A, B) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    call af_arr_scgt(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scgt_s(R%ptr, A%ptr, B, 0, err)
   end function array_gt_s
 
   function array_lgt_s(B, A) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A < dble(B)
+    call init_eq(R, A)
+    call af_arr_scgt_s(R%ptr, A%ptr, B, 1, err)
   end function array_lgt_s
 
   function array_gt_i(A, B) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    call af_arr_scgt(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scgt_i(R%ptr, A%ptr, B, 0, err)
   end function array_gt_i
 
   function array_lgt_i(B, A) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A < dble(B)
+    call init_eq(R, A)
+    call af_arr_scgt_i(R%ptr, A%ptr, B, 1, err)
   end function array_lgt_i
 
   function array_lt_d(A, B) result(R)
@@ -2412,42 +4729,47 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_sclt(R%ptr, A%ptr, B, err)
+    call af_arr_sclt_d(R%ptr, A%ptr, B, 0, err)
   end function array_lt_d
 
   function array_llt_d(B, A) result(R)
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A > B
+    call init_eq(R, A)
+    call af_arr_sclt_d(R%ptr, A%ptr, B, 1, err)
   end function array_llt_d
 
   function array_lt_s(A, B) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    call af_arr_sclt(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_sclt_s(R%ptr, A%ptr, B, 0, err)
   end function array_lt_s
 
   function array_llt_s(B, A) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A > dble(B)
+    call init_eq(R, A)
+    call af_arr_sclt_s(R%ptr, A%ptr, B, 1, err)
   end function array_llt_s
 
   function array_lt_i(A, B) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    call af_arr_sclt(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_sclt_i(R%ptr, A%ptr, B, 0, err)
   end function array_lt_i
 
   function array_llt_i(B, A) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A > dble(B)
+    call init_eq(R, A)
+    call af_arr_sclt_i(R%ptr, A%ptr, B, 1, err)
   end function array_llt_i
 
   function array_ge_d(A, B) result(R)
@@ -2455,42 +4777,47 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scge(R%ptr, A%ptr, B, err)
+    call af_arr_scge_d(R%ptr, A%ptr, B, 0, err)
   end function array_ge_d
 
   function array_lge_d(B, A) result(R)
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A <= B
+    call init_eq(R, A)
+    call af_arr_scge_d(R%ptr, A%ptr, B, 1, err)
   end function array_lge_d
 
   function array_ge_s(A, B) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    call af_arr_scge(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scge_s(R%ptr, A%ptr, B, 0, err)
   end function array_ge_s
 
   function array_lge_s(B, A) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A <= dble(B)
+    call init_eq(R, A)
+    call af_arr_scge_s(R%ptr, A%ptr, B, 1, err)
   end function array_lge_s
 
   function array_ge_i(A, B) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    call af_arr_scge(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scge_i(R%ptr, A%ptr, B, 0, err)
   end function array_ge_i
 
   function array_lge_i(B, A) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A <= dble(B)
+    call init_eq(R, A)
+    call af_arr_scge_i(R%ptr, A%ptr, B, 1, err)
   end function array_lge_i
 
   function array_le_d(A, B) result(R)
@@ -2498,42 +4825,47 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scle(R%ptr, A%ptr, B, err)
+    call af_arr_scle_d(R%ptr, A%ptr, B, 0, err)
   end function array_le_d
 
   function array_lle_d(B, A) result(R)
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A >= B
+    call init_eq(R, A)
+    call af_arr_scle_d(R%ptr, A%ptr, B, 1, err)
   end function array_lle_d
 
   function array_le_s(A, B) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    call af_arr_scle(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scle_s(R%ptr, A%ptr, B, 0, err)
   end function array_le_s
 
   function array_lle_s(B, A) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A >= dble(B)
+    call init_eq(R, A)
+    call af_arr_scle_s(R%ptr, A%ptr, B, 1, err)
   end function array_lle_s
 
   function array_le_i(A, B) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    call af_arr_scle(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scle_i(R%ptr, A%ptr, B, 0, err)
   end function array_le_i
 
   function array_lle_i(B, A) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A >= dble(B)
+    call init_eq(R, A)
+    call af_arr_scle_i(R%ptr, A%ptr, B, 1, err)
   end function array_lle_i
 
   function array_eq_d(A, B) result(R)
@@ -2541,42 +4873,47 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_sceq(R%ptr, A%ptr, B, err)
+    call af_arr_sceq_d(R%ptr, A%ptr, B, 0, err)
   end function array_eq_d
 
   function array_leq_d(B, A) result(R)
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A == B
+    call init_eq(R, A)
+    call af_arr_sceq_d(R%ptr, A%ptr, B, 1, err)
   end function array_leq_d
 
   function array_eq_s(A, B) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    call af_arr_sceq(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_sceq_s(R%ptr, A%ptr, B, 0, err)
   end function array_eq_s
 
   function array_leq_s(B, A) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A == dble(B)
+    call init_eq(R, A)
+    call af_arr_sceq_s(R%ptr, A%ptr, B, 1, err)
   end function array_leq_s
 
   function array_eq_i(A, B) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    call af_arr_sceq(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_sceq_i(R%ptr, A%ptr, B, 0, err)
   end function array_eq_i
 
   function array_leq_i(B, A) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A == dble(B)
+    call init_eq(R, A)
+    call af_arr_sceq_i(R%ptr, A%ptr, B, 1, err)
   end function array_leq_i
 
   function array_ne_d(A, B) result(R)
@@ -2584,42 +4921,47 @@ contains
     double precision, intent(in) :: B
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_scne(R%ptr, A%ptr, B, err)
+    call af_arr_scne_d(R%ptr, A%ptr, B, 0, err)
   end function array_ne_d
 
   function array_lne_d(B, A) result(R)
     type(array), intent(in) :: A
     double precision, intent(in) :: B
     type(array) :: R
-    R = A /= B
+    call init_eq(R, A)
+    call af_arr_scne_d(R%ptr, A%ptr, B, 1, err)
   end function array_lne_d
 
   function array_ne_s(A, B) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    call af_arr_scne(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scne_s(R%ptr, A%ptr, B, 0, err)
   end function array_ne_s
 
   function array_lne_s(B, A) result(R)
     type(array), intent(in) :: A
     real, intent(in) :: B
     type(array) :: R
-    R = A /= dble(B)
+    call init_eq(R, A)
+    call af_arr_scne_s(R%ptr, A%ptr, B, 1, err)
   end function array_lne_s
 
   function array_ne_i(A, B) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    call af_arr_scne(R%ptr, A%ptr, dble(B), err)
+    call init_eq(R, A)
+    call af_arr_scne_i(R%ptr, A%ptr, B, 0, err)
   end function array_ne_i
 
   function array_lne_i(B, A) result(R)
     type(array), intent(in) :: A
     integer, intent(in) :: B
     type(array) :: R
-    R = A /= dble(B)
+    call init_eq(R, A)
+    call af_arr_scne_i(R%ptr, A%ptr, B, 1, err)
   end function array_lne_i
 
   !> and on two array matrices
@@ -2696,149 +5038,833 @@ contains
     call af_arr_exp(R%ptr, A%ptr, err)
   end function array_exp
 
-  !> Multiply two array matrices
-  function array_matmul(A, B) result(R)
+  !> sqrt of array
+  function array_sqrt(A) result(R)
     type(array), intent(in) :: A
-    type(array), intent(in) :: B
     type(array) :: R
-    R%shape(1) = A%shape(1)
-    R%shape(2) = B%shape(2)
-    R%shape(3) = B%shape(1)
-    R%shape(4) = B%shape(1)
-    R%rank = 2
-    call af_arr_matmul(R%ptr, A%ptr, B%ptr, err)
-  end function array_matmul
+    call init_eq(R, A)
+    call af_arr_sqrt(R%ptr, A%ptr, err)
+  end function array_sqrt
 
-  !> Transpose an array
-  function array_transpose(A) result(R)
+  !> cbrt of array
+  function array_cbrt(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
-    R%shape(1) = A%shape(2)
-    R%shape(2) = A%shape(1)
-    R%shape(3) = A%shape(3)
-    R%shape(4) = A%shape(4)
-    R%rank = 2
-    call af_arr_t(R%ptr, A%ptr, err)
-  end function array_transpose
+    call init_eq(R, A)
+    call af_arr_cbrt(R%ptr, A%ptr, err)
+  end function array_cbrt
 
-  !> Htranspose an array
-  function array_htranspose(A) result(R)
+  !> asin of array
+  function array_asin(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
-    R%shape(1) = A%shape(2)
-    R%shape(2) = A%shape(1)
-    R%shape(3) = A%shape(3)
-    R%shape(4) = A%shape(4)
-    R%rank = 2
-    call af_arr_h(R%ptr, A%ptr, err)
-  end function array_htranspose
+    call init_eq(R, A)
+    call af_arr_asin(R%ptr, A%ptr, err)
+  end function array_asin
 
-  !> Reorder an array
-  function array_reorder(A, d1, d2, d3, d4) result(R)
+  !> acos of array
+  function array_acos(A) result(R)
     type(array), intent(in) :: A
-    integer, optional, intent(in) :: d1, d2, d3, d4
     type(array) :: R
-
     call init_eq(R, A)
-    if (present(d1)) R%shape(1) = d1
-    if (present(d2)) R%shape(2) = d2
-    if (present(d3)) R%shape(3) = d3
-    if (present(d4)) R%shape(4) = d4
+    call af_arr_acos(R%ptr, A%ptr, err)
+  end function array_acos
 
-    call af_arr_t(R%ptr, A%ptr, R%shape, err)
-  end function array_reorder
+  !> atan of array
+  function array_atan(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_atan(R%ptr, A%ptr, err)
+  end function array_atan
 
-  !> Sort an array
-  function array_sort(A) result(R)
+  !> sinh of array
+  function array_sinh(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_sort(R%ptr, A%ptr, err)
-  end function array_sort
+    call af_arr_sinh(R%ptr, A%ptr, err)
+  end function array_sinh
 
-  !> Lower triangular matrix of a matrix
-  function array_lower(A) result(R)
+  !> cosh of array
+  function array_cosh(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_lower(R%ptr, A%ptr, err)
-  end function array_lower
+    call af_arr_cosh(R%ptr, A%ptr, err)
+  end function array_cosh
 
-  !> Upper triangular matrix of a matrix
-  function array_upper(A) result(R)
+  !> tanh of array
+  function array_tanh(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_upper(R%ptr, A%ptr, err)
-  end function array_upper
+    call af_arr_tanh(R%ptr, A%ptr, err)
+  end function array_tanh
 
-  !> Diag triangular matrix of a matrix
-  function array_diag(A) result(R)
+  !> asinh of array
+  function array_asinh(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_diag(R%ptr, A%ptr, err)
-  end function array_diag
+    call af_arr_asinh(R%ptr, A%ptr, err)
+  end function array_asinh
 
-  !> Real triangular matrix of a matrix
-  function array_real(A) result(R)
+  !> acosh of array
+  function array_acosh(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_real(R%ptr, A%ptr, err)
-  end function array_real
+    call af_arr_acosh(R%ptr, A%ptr, err)
+  end function array_acosh
 
-  !> Imag triangular matrix of a matrix
-  function array_imag(A) result(R)
+  !> atanh of array
+  function array_atanh(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_imag(R%ptr, A%ptr, err)
-  end function array_imag
+    call af_arr_atanh(R%ptr, A%ptr, err)
+  end function array_atanh
 
-  !> Create complex matrix from input matrix
-  function array_complex(A) result(R)
+  !> log10 of array
+  function array_log10(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_complex(R%ptr, A%ptr, err)
-  end function array_complex
+    call af_arr_log10(R%ptr, A%ptr, err)
+  end function array_log10
 
-  !>  Create complex matrix from two (real, imaginary) matrices
-  function array_complex2(Re, Im) result(Cplx)
-    type(array), intent(in) :: Re, Im
-    type(array) :: Cplx
-    call init_eq(Cplx, Re)
-    call af_arr_complex2(Cplx%ptr, Re%ptr, Im%ptr, err)
-  end function array_complex2
+  !> log2 of array
+  function array_log2(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_log2(R%ptr, A%ptr, err)
+  end function array_log2
 
-  !> Create conjugate matrix from input matrix
-  function array_conjg(A) result(R)
+  !> log1p of array
+  function array_log1p(A) result(R)
     type(array), intent(in) :: A
     type(array) :: R
     call init_eq(R, A)
-    call af_arr_conjg(R%ptr, A%ptr, err)
-  end function array_conjg
+    call af_arr_log1p(R%ptr, A%ptr, err)
+  end function array_log1p
 
-  !> Norm of an array
-  function array_norm(A) result(R)
+  !> expm1 of array
+  function array_expm1(A) result(R)
     type(array), intent(in) :: A
-    double precision :: R
-    call af_arr_norm(R, A%ptr, err)
-  end function array_norm
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_expm1(R%ptr, A%ptr, err)
+  end function array_expm1
 
-  !> Norm of an array
-  function array_pnorm(A, p) result(R)
+  !> erf of array
+  function array_erf(A) result(R)
     type(array), intent(in) :: A
-    real, intent(in) :: p
-    double precision :: R
-    call af_arr_pnorm(R, A%ptr, p, err)
-  end function array_pnorm
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_erf(R%ptr, A%ptr, err)
+  end function array_erf
 
-  !> LU decomposition of array
-  subroutine array_lu(L, U, p, A)
+  !> erfc of array
+  function array_erfc(A) result(R)
     type(array), intent(in) :: A
-    type(array), intent(inout) :: L
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_erfc(R%ptr, A%ptr, err)
+  end function array_erfc
+
+  !> tgamma of array
+  function array_tgamma(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_tgamma(R%ptr, A%ptr, err)
+  end function array_tgamma
+
+  !> lgamma of array
+  function array_lgamma(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_lgamma(R%ptr, A%ptr, err)
+  end function array_lgamma
+
+  !> floor of array
+  function array_floor(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_floor(R%ptr, A%ptr, err)
+  end function array_floor
+
+  !> ceil of array
+  function array_ceil(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_ceil(R%ptr, A%ptr, err)
+  end function array_ceil
+
+  !> round of array
+  function array_round(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_round(R%ptr, A%ptr, err)
+  end function array_round
+
+  !> trunc of array
+  function array_trunc(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_trunc(R%ptr, A%ptr, err)
+  end function array_trunc
+
+  !> sign of array
+  function array_sign(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_sign(R%ptr, A%ptr, err)
+  end function array_sign
+
+  !> isnan of array
+  function array_isnan(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_isnan(R%ptr, A%ptr, err)
+  end function array_isnan
+
+  !> isinf of array
+  function array_isinf(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_isinf(R%ptr, A%ptr, err)
+  end function array_isinf
+
+  !> iszero of array
+  function array_iszero(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_iszero(R%ptr, A%ptr, err)
+  end function array_iszero
+
+  !> atan2 of two arrays (element wise)
+  function array_atan2(A, B) result(R)
+    type(array), intent(in) :: A, B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_elatan2(R%ptr, A%ptr, B%ptr, err)
+  end function array_atan2
+
+  !> atan2 of array and scalar
+  function array_atan2_d(A, B) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scatan2_d(R%ptr, A%ptr, B, 0, err)
+  end function array_atan2_d
+
+  !> atan2 of scalar and array
+  function array_latan2_d(A, B) result(R)
+    double precision, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scatan2_d(R%ptr, B%ptr, A, 1, err)
+  end function array_latan2_d
+
+  !> atan2 of array and scalar
+  function array_atan2_s(A, B) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scatan2_s(R%ptr, A%ptr, B, 0, err)
+  end function array_atan2_s
+
+  !> atan2 of scalar and array
+  function array_latan2_s(A, B) result(R)
+    real, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scatan2_s(R%ptr, B%ptr, A, 1, err)
+  end function array_latan2_s
+
+  !> atan2 of array and scalar
+  function array_atan2_i(A, B) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scatan2_i(R%ptr, A%ptr, B, 0, err)
+  end function array_atan2_i
+
+  !> atan2 of scalar and array
+  function array_latan2_i(A, B) result(R)
+    integer, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scatan2_i(R%ptr, B%ptr, A, 1, err)
+  end function array_latan2_i
+
+  !> hypot of two arrays (element wise)
+  function array_hypot(A, B) result(R)
+    type(array), intent(in) :: A, B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_elhypot(R%ptr, A%ptr, B%ptr, err)
+  end function array_hypot
+
+  !> hypot of array and scalar
+  function array_hypot_d(A, B) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_schypot_d(R%ptr, A%ptr, B, 0, err)
+  end function array_hypot_d
+
+  !> hypot of scalar and array
+  function array_lhypot_d(A, B) result(R)
+    double precision, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_schypot_d(R%ptr, B%ptr, A, 1, err)
+  end function array_lhypot_d
+
+  !> hypot of array and scalar
+  function array_hypot_s(A, B) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_schypot_s(R%ptr, A%ptr, B, 0, err)
+  end function array_hypot_s
+
+  !> hypot of scalar and array
+  function array_lhypot_s(A, B) result(R)
+    real, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_schypot_s(R%ptr, B%ptr, A, 1, err)
+  end function array_lhypot_s
+
+  !> hypot of array and scalar
+  function array_hypot_i(A, B) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_schypot_i(R%ptr, A%ptr, B, 0, err)
+  end function array_hypot_i
+
+  !> hypot of scalar and array
+  function array_lhypot_i(A, B) result(R)
+    integer, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_schypot_i(R%ptr, B%ptr, A, 1, err)
+  end function array_lhypot_i
+
+  !> mod of two arrays (element wise)
+  function array_mod(A, B) result(R)
+    type(array), intent(in) :: A, B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_elmod(R%ptr, A%ptr, B%ptr, err)
+  end function array_mod
+
+  !> mod of array and scalar
+  function array_mod_d(A, B) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmod_d(R%ptr, A%ptr, B, 0, err)
+  end function array_mod_d
+
+  !> mod of scalar and array
+  function array_lmod_d(A, B) result(R)
+    double precision, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmod_d(R%ptr, B%ptr, A, 1, err)
+  end function array_lmod_d
+
+  !> mod of array and scalar
+  function array_mod_s(A, B) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmod_s(R%ptr, A%ptr, B, 0, err)
+  end function array_mod_s
+
+  !> mod of scalar and array
+  function array_lmod_s(A, B) result(R)
+    real, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmod_s(R%ptr, B%ptr, A, 1, err)
+  end function array_lmod_s
+
+  !> mod of array and scalar
+  function array_mod_i(A, B) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmod_i(R%ptr, A%ptr, B, 0, err)
+  end function array_mod_i
+
+  !> mod of scalar and array
+  function array_lmod_i(A, B) result(R)
+    integer, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmod_i(R%ptr, B%ptr, A, 1, err)
+  end function array_lmod_i
+
+  !> modulo of two arrays (element wise)
+  function array_modulo(A, B) result(R)
+    type(array), intent(in) :: A, B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_elmodulo(R%ptr, A%ptr, B%ptr, err)
+  end function array_modulo
+
+  !> modulo of array and scalar
+  function array_modulo_d(A, B) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmodulo_d(R%ptr, A%ptr, B, 0, err)
+  end function array_modulo_d
+
+  !> modulo of scalar and array
+  function array_lmodulo_d(A, B) result(R)
+    double precision, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmodulo_d(R%ptr, B%ptr, A, 1, err)
+  end function array_lmodulo_d
+
+  !> modulo of array and scalar
+  function array_modulo_s(A, B) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmodulo_s(R%ptr, A%ptr, B, 0, err)
+  end function array_modulo_s
+
+  !> modulo of scalar and array
+  function array_lmodulo_s(A, B) result(R)
+    real, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmodulo_s(R%ptr, B%ptr, A, 1, err)
+  end function array_lmodulo_s
+
+  !> modulo of array and scalar
+  function array_modulo_i(A, B) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmodulo_i(R%ptr, A%ptr, B, 0, err)
+  end function array_modulo_i
+
+  !> modulo of scalar and array
+  function array_lmodulo_i(A, B) result(R)
+    integer, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmodulo_i(R%ptr, B%ptr, A, 1, err)
+  end function array_lmodulo_i
+
+  !> min of two arrays (element wise)
+  function array_elmin(A, B) result(R)
+    type(array), intent(in) :: A, B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_elmin(R%ptr, A%ptr, B%ptr, err)
+  end function array_elmin
+
+  !> min of array and scalar
+  function array_min_d(A, B) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmin_d(R%ptr, A%ptr, B, 0, err)
+  end function array_min_d
+
+  !> min of scalar and array
+  function array_lmin_d(A, B) result(R)
+    double precision, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmin_d(R%ptr, B%ptr, A, 1, err)
+  end function array_lmin_d
+
+  !> min of array and scalar
+  function array_min_s(A, B) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmin_s(R%ptr, A%ptr, B, 0, err)
+  end function array_min_s
+
+  !> min of scalar and array
+  function array_lmin_s(A, B) result(R)
+    real, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmin_s(R%ptr, B%ptr, A, 1, err)
+  end function array_lmin_s
+
+  !> max of two arrays (element wise)
+  function array_elmax(A, B) result(R)
+    type(array), intent(in) :: A, B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_elmax(R%ptr, A%ptr, B%ptr, err)
+  end function array_elmax
+
+  !> max of array and scalar
+  function array_max_d(A, B) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmax_d(R%ptr, A%ptr, B, 0, err)
+  end function array_max_d
+
+  !> max of scalar and array
+  function array_lmax_d(A, B) result(R)
+    double precision, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmax_d(R%ptr, B%ptr, A, 1, err)
+  end function array_lmax_d
+
+  !> max of array and scalar
+  function array_max_s(A, B) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scmax_s(R%ptr, A%ptr, B, 0, err)
+  end function array_max_s
+
+  !> max of scalar and array
+  function array_lmax_s(A, B) result(R)
+    real, intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    call init_eq(R, B)
+    call af_arr_scmax_s(R%ptr, B%ptr, A, 1, err)
+  end function array_lmax_s
+
+  !> Select elements from two arrays
+  function array_select(cond, A, B) result(R)
+    type(array), intent(in) :: cond, A, B
+    type(array) :: R
+    call init_eq(R, cond)
+    call af_arr_select(R%ptr, cond%ptr, A%ptr, B%ptr, err)
+  end function array_select
+
+  !> Select elements from an array or a scalar
+  function array_select_d(cond, A, B) result(R)
+    type(array), intent(in) :: cond, A
+    double precision, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, cond)
+    call af_arr_scselect_d(R%ptr, cond%ptr, A%ptr, B, 0, err)
+  end function array_select_d
+
+  !> Select elements from a scalar or an array
+  function array_lselect_d(cond, A, B) result(R)
+    type(array), intent(in) :: cond, B
+    double precision, intent(in) :: A
+    type(array) :: R
+    call init_eq(R, cond)
+    call af_arr_scselect_d(R%ptr, cond%ptr, B%ptr, A, 1, err)
+  end function array_lselect_d
+
+  !> Select elements from an array or a scalar
+  function array_select_s(cond, A, B) result(R)
+    type(array), intent(in) :: cond, A
+    real, intent(in) :: B
+    type(array) :: R
+    call init_eq(R, cond)
+    call af_arr_scselect_s(R%ptr, cond%ptr, A%ptr, B, 0, err)
+  end function array_select_s
+
+  !> Select elements from a scalar or an array
+  function array_lselect_s(cond, A, B) result(R)
+    type(array), intent(in) :: cond, B
+    real, intent(in) :: A
+    type(array) :: R
+    call init_eq(R, cond)
+    call af_arr_scselect_s(R%ptr, cond%ptr, B%ptr, A, 1, err)
+  end function array_lselect_s
+
+  !> Clamp an array between two arrays
+  function array_clamp(A, lo, hi) result(R)
+    type(array), intent(in) :: A, lo, hi
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_clamp(R%ptr, A%ptr, lo%ptr, hi%ptr, err)
+  end function array_clamp
+
+  !> Clamp an array between two scalars
+  function array_clamp_d(A, lo, hi) result(R)
+    type(array), intent(in) :: A
+    double precision, intent(in) :: lo, hi
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scclamp_d(R%ptr, A%ptr, lo, hi, err)
+  end function array_clamp_d
+
+  !> Clamp an array between two scalars
+  function array_clamp_s(A, lo, hi) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: lo, hi
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_scclamp_s(R%ptr, A%ptr, lo, hi, err)
+  end function array_clamp_s
+
+  !> Multiply two array matrices
+  function array_matmul(A, B) result(R)
+    type(array), intent(in) :: A
+    type(array), intent(in) :: B
+    type(array) :: R
+    R%shape(1) = A%shape(1)
+    R%shape(2) = B%shape(2)
+    R%shape(3) = B%shape(1)
+    R%shape(4) = B%shape(1)
+    R%rank = 2
+    call af_arr_matmul(R%ptr, A%ptr, B%ptr, err)
+  end function array_matmul
+
+  !> Transpose an array
+  function array_transpose(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    R%shape(1) = A%shape(2)
+    R%shape(2) = A%shape(1)
+    R%shape(3) = A%shape(3)
+    R%shape(4) = A%shape(4)
+    R%rank = 2
+    call af_arr_t(R%ptr, A%ptr, err)
+  end function array_transpose
+
+  !> Htranspose an array
+  function array_htranspose(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    R%shape(1) = A%shape(2)
+    R%shape(2) = A%shape(1)
+    R%shape(3) = A%shape(3)
+    R%shape(4) = A%shape(4)
+    R%rank = 2
+    call af_arr_h(R%ptr, A%ptr, err)
+  end function array_htranspose
+
+  !> Reorder an array
+  function array_reorder(A, d1, d2, d3, d4) result(R)
+    type(array), intent(in) :: A
+    integer, optional, intent(in) :: d1, d2, d3, d4
+    type(array) :: R
+    integer :: x(4)
+
+    x = [1, 2, 3, 4]
+    if (present(d1)) x(1) = d1
+    if (present(d2)) x(2) = d2
+    if (present(d3)) x(3) = d3
+    if (present(d4)) x(4) = d4
+
+    call af_arr_reorder(R%ptr, A%ptr, x, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_reorder
+
+  !> Sort an array
+  function array_sort(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_sort(R%ptr, A%ptr, err)
+  end function array_sort
+
+  !> Sort an array and return indices
+  subroutine array_sort_index(out, idx, A, d, ascending)
+    type(array), intent(in) :: A
+    type(array), intent(inout) :: out, idx
+    integer, optional, intent(in) :: d
+    logical, optional, intent(in) :: ascending
+    integer :: dim, asc
+    dim = 1
+    asc = 1
+    if (present(d)) dim = d
+    if (present(ascending)) then
+       if (.not. ascending) asc = 0
+    end if
+    call init_eq(out, A)
+    call init_eq(idx, A)
+    call af_arr_sort_index(out%ptr, idx%ptr, A%ptr, dim, asc, err)
+  end subroutine array_sort_index
+
+  !> Sort values by keys
+  subroutine array_sort_by_key(okeys, ovals, keys, vals, d, ascending)
+    type(array), intent(in) :: keys, vals
+    type(array), intent(inout) :: okeys, ovals
+    integer, optional, intent(in) :: d
+    logical, optional, intent(in) :: ascending
+    integer :: dim, asc
+    dim = 1
+    asc = 1
+    if (present(d)) dim = d
+    if (present(ascending)) then
+       if (.not. ascending) asc = 0
+    end if
+    call init_eq(okeys, keys)
+    call init_eq(ovals, vals)
+    call af_arr_sort_by_key(okeys%ptr, ovals%ptr, keys%ptr, vals%ptr, dim, asc, err)
+  end subroutine array_sort_by_key
+
+  !> k largest or smallest elements of an array
+  subroutine array_topk(val, idx, A, k, largest)
+    type(array), intent(in) :: A
+    type(array), intent(inout) :: val, idx
+    integer, intent(in) :: k
+    logical, optional, intent(in) :: largest
+    integer :: lg
+    lg = 1
+    if (present(largest)) then
+       if (.not. largest) lg = 0
+    end if
+    call af_arr_topk(val%ptr, idx%ptr, A%ptr, k, lg, err)
+    call init_post(val%ptr, val%shape, val%rank)
+    call init_post(idx%ptr, idx%shape, idx%rank)
+  end subroutine array_topk
+
+  !> Indices of non zero elements of an array
+  function array_where(mask) result(R)
+    type(array), intent(in) :: mask
+    type(array) :: R
+    call af_arr_where(R%ptr, mask%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_where
+
+  !> Lower triangular matrix of a matrix
+  function array_lower(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_lower(R%ptr, A%ptr, err)
+  end function array_lower
+
+  !> Upper triangular matrix of a matrix
+  function array_upper(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_upper(R%ptr, A%ptr, err)
+  end function array_upper
+
+  !> Diag triangular matrix of a matrix
+  function array_diag(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_diag(R%ptr, A%ptr, err)
+  end function array_diag
+
+  !> Real triangular matrix of a matrix
+  function array_real(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_real(R%ptr, A%ptr, err)
+  end function array_real
+
+  !> Imag triangular matrix of a matrix
+  function array_imag(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_imag(R%ptr, A%ptr, err)
+  end function array_imag
+
+  !> Create complex matrix from input matrix
+  function array_complex(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_complex(R%ptr, A%ptr, err)
+  end function array_complex
+
+  !>  Create complex matrix from two (real, imaginary) matrices
+  function array_complex2(Re, Im) result(Cplx)
+    type(array), intent(in) :: Re, Im
+    type(array) :: Cplx
+    call init_eq(Cplx, Re)
+    call af_arr_complex2(Cplx%ptr, Re%ptr, Im%ptr, err)
+  end function array_complex2
+
+  !> Create conjugate matrix from input matrix
+  function array_conjg(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call init_eq(R, A)
+    call af_arr_conjg(R%ptr, A%ptr, err)
+  end function array_conjg
+
+  !> Norm of an array
+  function array_norm(A) result(R)
+    type(array), intent(in) :: A
+    double precision :: R
+    call af_arr_norm(R, A%ptr, err)
+  end function array_norm
+
+  !> Norm of an array
+  function array_pnorm(A, p) result(R)
+    type(array), intent(in) :: A
+    real, intent(in) :: p
+    double precision :: R
+    call af_arr_pnorm(R, A%ptr, p, err)
+  end function array_pnorm
+
+  !> LU decomposition of array
+  subroutine array_lu(L, U, p, A)
+    type(array), intent(in) :: A
+    type(array), intent(inout) :: L
     type(array), intent(inout) :: U
     type(array), intent(inout) :: p
     call init_eq(L, A)
@@ -2903,6 +5929,30 @@ contains
     call af_arr_solve(X%ptr, A%ptr, B%ptr, err)
   end function array_solve
 
+  !> Solve a system of equations with mixed precision iterative refinement
+  function array_solve_refined(A, B, tol, maxit, iter, resid) result(X)
+    type(array), intent(in) :: A, B
+    double precision, intent(in), optional :: tol
+    integer, intent(in), optional :: maxit
+    integer, intent(out), optional :: iter
+    double precision, intent(out), optional :: resid
+    type(array) :: X
+    double precision :: tt, rr
+    integer :: mm, it
+
+    tt = epsilon(1d0) * sqrt(dble(A%shape(1)))
+    mm = 30
+    if (present(tol)) tt = tol
+    if (present(maxit)) mm = maxit
+
+    call init_eq(X, B)
+    X%shape(1) = A%shape(2)
+    call af_arr_solve_refined(X%ptr, A%ptr, B%ptr, tt, mm, it, rr, err)
+
+    if (present(iter)) iter = it
+    if (present(resid)) resid = rr
+  end function array_solve_refined
+
   !> Inverse an array
   function array_inverse(A) result(R)
     type(array), intent(in) :: A
@@ -2935,6 +5985,23 @@ contains
     call af_arr_product(R%ptr, A%ptr, dim, err)
   end function array_product
 
+  !> Prefix sum of elements in a matrix
+  function array_scan (A, d, inclusive) result(R)
+    type(array), intent(in) :: A
+    integer, optional, intent(in) :: d
+    logical, optional, intent(in) :: inclusive
+    type(array) :: R
+    integer :: dim, inc
+    dim = 1
+    inc = 1
+    if (present(d)) dim = d
+    if (present(inclusive)) then
+       if (.not. inclusive) inc = 0
+    end if
+    call init_eq(R, A)
+    call af_arr_scan(R%ptr, A%ptr, dim, inc, err)
+  end function array_scan
+
   !> Minimum of elements in a matrix
   function array_min (A, d) result(R)
     type(array), intent(in) :: A
@@ -2959,6 +6026,45 @@ contains
     call af_arr_max(R%ptr, A%ptr, dim, err)
   end function array_max
 
+  !> Minimum of elements in a matrix and its location
+  subroutine array_imin(val, loc, A, d)
+    type(array), intent(in) :: A
+    integer, optional, intent(in) :: d
+    type(array), intent(inout) :: val, loc
+    integer :: dim
+    dim = 1
+    if (present(d)) dim = d
+    call af_arr_imin(val%ptr, loc%ptr, A%ptr, dim, err)
+    call init_post(val%ptr, val%shape, val%rank)
+    call init_post(loc%ptr, loc%shape, loc%rank)
+  end subroutine array_imin
+
+  !> Maximum of elements in a matrix and its location
+  subroutine array_imax(val, loc, A, d)
+    type(array), intent(in) :: A
+    integer, optional, intent(in) :: d
+    type(array), intent(inout) :: val, loc
+    integer :: dim
+    dim = 1
+    if (present(d)) dim = d
+    call af_arr_imax(val%ptr, loc%ptr, A%ptr, dim, err)
+    call init_post(val%ptr, val%shape, val%rank)
+    call init_post(loc%ptr, loc%shape, loc%rank)
+  end subroutine array_imax
+
+  !> Minimum and maximum of elements in a matrix
+  subroutine array_minmax(mn, mx, A, d)
+    type(array), intent(in) :: A
+    integer, optional, intent(in) :: d
+    type(array), intent(inout) :: mn, mx
+    integer :: dim
+    dim = 1
+    if (present(d)) dim = d
+    call af_arr_minmax(mn%ptr, mx%ptr, A%ptr, dim, err)
+    call init_post(mn%ptr, mn%shape, mn%rank)
+    call init_post(mx%ptr, mx%shape, mx%rank)
+  end subroutine array_minmax
+
   !> Any of elements in a matrix
   function array_anytrue (A, d) result(R)
     type(array), intent(in) :: A
@@ -3019,6 +6125,139 @@ contains
     call af_arr_var(R%ptr, A%ptr, dim, err)
   end function array_var
 
+  !> Mean and variance of elements in a matrix
+  subroutine array_mean_var(mu, s2, A, d)
+    type(array), intent(in) :: A
+    integer, optional, intent(in) :: d
+    type(array), intent(inout) :: mu, s2
+    integer :: dim
+    dim = 1
+    if (present(d)) dim = d
+    call af_arr_mean_var(mu%ptr, s2%ptr, A%ptr, dim, err)
+    call init_post(mu%ptr, mu%shape, mu%rank)
+    call init_post(s2%ptr, s2%shape, s2%rank)
+  end subroutine array_mean_var
+
+  !> Fast fourier transform of an array
+  function array_fft(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call af_arr_fft(R%ptr, A%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_fft
+
+  !> Inverse fast fourier transform of an array
+  function array_ifft(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call af_arr_ifft(R%ptr, A%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_ifft
+
+  !> Two dimensional fast fourier transform of an array
+  function array_fft2(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call af_arr_fft2(R%ptr, A%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_fft2
+
+  !> Two dimensional inverse fast fourier transform of an array
+  function array_ifft2(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call af_arr_ifft2(R%ptr, A%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_ifft2
+
+  !> Three dimensional fast fourier transform of an array
+  function array_fft3(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call af_arr_fft3(R%ptr, A%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_fft3
+
+  !> Three dimensional inverse fast fourier transform of an array
+  function array_ifft3(A) result(R)
+    type(array), intent(in) :: A
+    type(array) :: R
+    call af_arr_ifft3(R%ptr, A%ptr, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_ifft3
+
+  !> Real to complex fast fourier transform of an array
+  function array_fftr2c(A, rank) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: rank
+    type(array) :: R
+    call af_arr_fftr2c(R%ptr, A%ptr, rank, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_fftr2c
+
+  !> Complex to real inverse fast fourier transform of an array
+  function array_fftc2r(A, rank, is_odd) result(R)
+    type(array), intent(in) :: A
+    integer, intent(in) :: rank
+    logical, intent(in), optional :: is_odd
+    type(array) :: R
+    integer :: odd
+    odd = 0
+    if (present(is_odd)) then
+       if (is_odd) odd = 1
+    end if
+    call af_arr_fftc2r(R%ptr, A%ptr, rank, odd, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_fftc2r
+
+  !> Set the size of the fft plan cache
+  subroutine fft_plan_cache_(n)
+    integer, intent(in) :: n
+    call af_fft_plan_cache(n)
+  end subroutine fft_plan_cache_
+
+  !> One dimensional convolution of an array
+  function array_convolve1(A, F, expand) result(R)
+    type(array), intent(in) :: A, F
+    logical, intent(in), optional :: expand
+    type(array) :: R
+    integer :: ex
+    ex = 0
+    if (present(expand)) then
+       if (expand) ex = 1
+    end if
+    call af_arr_convolve1(R%ptr, A%ptr, F%ptr, ex, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_convolve1
+
+  !> Two dimensional convolution of an array
+  function array_convolve2(A, F, expand) result(R)
+    type(array), intent(in) :: A, F
+    logical, intent(in), optional :: expand
+    type(array) :: R
+    integer :: ex
+    ex = 0
+    if (present(expand)) then
+       if (expand) ex = 1
+    end if
+    call af_arr_convolve2(R%ptr, A%ptr, F%ptr, ex, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_convolve2
+
+  !> Three dimensional convolution of an array
+  function array_convolve3(A, F, expand) result(R)
+    type(array), intent(in) :: A, F
+    logical, intent(in), optional :: expand
+    type(array) :: R
+    integer :: ex
+    ex = 0
+    if (present(expand)) then
+       if (expand) ex = 1
+    end if
+    call af_arr_convolve3(R%ptr, A%ptr, F%ptr, ex, err)
+    call init_post(R%ptr, R%shape, R%rank)
+  end function array_convolve3
+
   !> Show device info
   subroutine device_info_()
     call af_device_info()
@@ -3053,6 +6292,84 @@ contains
     call af_device_count(R)
   end function device_count_
 
+  !> Set the backend
+  subroutine backend_set_(b)
+    integer, intent(in) :: b
+    call af_backend_set(b, err)
+  end subroutine backend_set_
+
+  !> Get the backend
+  function backend_get_() result(R)
+    integer :: R
+    call af_backend_get(R)
+  end function backend_get_
+
+  !> Show backend count
+  function backend_count_() result(R)
+    integer :: R
+    call af_backend_count(R)
+  end function backend_count_
+
+  !> Check backend availability
+  function backend_available_(b) result(R)
+    integer, intent(in) :: b
+    logical :: R
+    integer :: avail
+    call af_backend_available(b, avail)
+    R = (avail /= 0)
+  end function backend_available_
+
+  !> Start recording a graph
+  subroutine graph_begin_(g, inputs)
+    type(graph), intent(inout) :: g
+    type(array), intent(in) :: inputs(:)
+    type(C_ptr) :: p(size(inputs))
+    integer :: i
+    do i = 1, size(inputs)
+       p(i) = inputs(i)%ptr
+    end do
+    call af_graph_begin(g%ptr, p, size(inputs), err)
+  end subroutine graph_begin_
+
+  !> Stop recording a graph
+  subroutine graph_end_(g, outputs)
+    type(graph), intent(inout) :: g
+    type(array), intent(in) :: outputs(:)
+    type(C_ptr) :: p(size(outputs))
+    integer :: i
+    do i = 1, size(outputs)
+       p(i) = outputs(i)%ptr
+    end do
+    call af_graph_end(g%ptr, p, size(outputs), err)
+  end subroutine graph_end_
+
+  !> Replay a recorded graph
+  subroutine graph_run_(g, inputs, outputs)
+    type(graph), intent(in) :: g
+    type(array), intent(in) :: inputs(:)
+    type(array), intent(inout) :: outputs(:)
+    type(C_ptr) :: pin(size(inputs))
+    type(C_ptr) :: pout(size(outputs))
+    integer :: i
+    do i = 1, size(inputs)
+       pin(i) = inputs(i)%ptr
+    end do
+    do i = 1, size(outputs)
+       pout(i) = outputs(i)%ptr
+    end do
+    call af_graph_run(g%ptr, pin, size(inputs), pout, size(outputs), err)
+    do i = 1, size(outputs)
+       outputs(i)%ptr = pout(i)
+       call init_post(outputs(i)%ptr, outputs(i)%shape, outputs(i)%rank)
+    end do
+  end subroutine graph_run_
+
+  !> Release a recorded graph
+  subroutine graph_free_(g)
+    type(graph), intent(inout) :: g
+    call af_graph_free(g%ptr)
+  end subroutine graph_free_
+
   !> Show device start
   subroutine timer_start_()
     call af_timer_start()
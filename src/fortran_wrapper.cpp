@@ -1,30 +1,43 @@
 #include <arrayfire.h>
 #include <af/util.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <vector>
+#include <map>
 #include <algorithm>
+#include <functional>
 
 using namespace af;
-using namespace std;
+using std::vector;
+using std::map;
 
+// Temporaries and the temporaries they were computed from. Children are
+// kept as handles, pointers into vec would not survive a reallocation.
 typedef struct node {
     void *curr;
-    struct node *left;
-    struct node *right;
+    void *left;
+    void *right;
+    void *third;
     bool cleanup;
 } Node;
 
 vector<Node> vec;
 
+void graph_forget(void *ptr);
+
 void destroy(void *ptr)
 {
     for (int i = 0; i < vec.size(); i++){
 
-        if (vec[i].curr == ptr) {
-            if (vec[i].left ) destroy(vec[i].left->curr );
-            if (vec[i].right) destroy(vec[i].right->curr);
-            delete (array *)vec[i].curr;
+        if (vec[i].curr == ptr && !vec[i].cleanup) {
+            Node n = vec[i];
             vec[i].cleanup = true;
+            if (n.left ) destroy(n.left );
+            if (n.right) destroy(n.right);
+            if (n.third) destroy(n.third);
+            graph_forget(n.curr);
+            delete (array *)n.curr;
             return;
         }
 
@@ -46,323 +59,868 @@ void cleanup(void *ptr)
     int l = getnode(ptr);
     if (l < 0) return;
 
-    if (vec[l].left ) destroy(vec[l].left->curr );
-    if (vec[l].right) destroy(vec[l].right->curr);
+    Node n = vec[l];
     vec[l].cleanup = true;
+    if (n.left ) destroy(n.left );
+    if (n.right) destroy(n.right);
+    if (n.third) destroy(n.third);
 
     vec.erase(std::remove_if(vec.begin(), vec.end(), iscleanup), vec.end());
 }
 
-void vec_add(void *dst, void *in1=NULL, void *in2=NULL)
+// A recorded operation: slots[out] = fn(slots[in1], slots[in2], slots[in3])
+typedef std::function<void(array &, const array &, const array &)> Op;
+typedef std::function<void(array &, const array &, const array &, const array &)> Op3;
+
+typedef struct step {
+    int out;
+    int in1;
+    int in2;
+    int in3;
+    Op3 fn;
+} Step;
+
+typedef struct graph {
+    vector<array> slots;
+    vector<bool> temp;
+    vector<Step> steps;
+    vector<int> inputs;
+    vector<int> outputs;
+    map<void *, int> handles;
+} Graph;
+
+Graph *capturing = NULL;
+
+// The allocator hands the address of a deleted array out again, so handles
+// must be dropped from the graph when they are deleted or handed out by an
+// operation that is not recorded. Otherwise graph_input would map the new
+// array to the slot of the old one.
+void graph_forget(void *ptr)
 {
-    int l = getnode(in1);
-    int r = getnode(in2);
-    Node *left  = (l < 0) ? NULL : &vec[l];
-    Node *right = (r < 0) ? NULL : &vec[r];
-    Node n = {dst, left, right, false};
-    vec.push_back(n);
+    if (capturing && ptr) capturing->handles.erase(ptr);
 }
 
-extern "C" {
+int graph_slot(Graph *g, const array &a, bool temp)
+{
+    g->slots.push_back(a);
+    g->temp.push_back(temp);
+    return g->slots.size() - 1;
+}
 
-    void af_device_info_() { af::info(); return; }
-    void af_device_get_(int *n) { *n = getDevice(); return; }
-    void af_device_set_(int *n) { setDevice(*n); return; }
-    void af_device_count_(int *n) {*n = getDeviceCount(); return; }
-
-    void af_device_eval_(void **arr) { af::eval(*(array *)arr); return; }
-    void af_device_sync_() { af::sync(); return; }
-
-    void af_timer_start_() { timer::start(); return; }
-    void af_timer_stop_(double *elapsed) { *elapsed = timer::stop(); return; }
-
-#define DEVICE(X, ty)                               \
-    void af_arr_device_##X##_(void **ptr, ty *a,    \
-                              int *shape, int *err) \
-    {                                               \
-        try {                                       \
-            *ptr = (void *)new array();             \
-            array *tmp = (array *)*ptr;             \
-            *tmp = array(shape[0], shape[1],        \
-                         shape[2], shape[3], a);    \
-            vec_add(*ptr);                          \
-        } catch (af::exception& ex) {               \
-            *err = 1;                               \
-            printf("%s\n", ex.what());              \
-            exit(-1);                               \
-        }                                           \
-    }                                               \
-
-    DEVICE(s, float);
-    DEVICE(d, double);
-    DEVICE(c, cfloat);
-    DEVICE(z, cdouble);
-
-    void af_arr_copy_(void **dst, void **src, int *err)
-    {
-        try {
-            if (*dst) delete (array *)*dst;
-            *dst = *src;
-            cleanup(*dst);
-        } catch (af::exception& ex) {
-            *err = 2;
-            printf("%s\n", ex.what());
+// Arrays that were not produced inside the graph are captured by value
+int graph_input(Graph *g, void *ptr)
+{
+    if (ptr == NULL) return -1;
+    map<void *, int>::iterator it = g->handles.find(ptr);
+    if (it != g->handles.end()) return it->second;
+    int s = graph_slot(g, *(array *)ptr, false);
+    g->handles[ptr] = s;
+    return s;
+}
+
+// Operations that are not recorded can not read or modify arrays produced
+// inside the graph, their result would be frozen to the captured values.
+void graph_check(void *a, void *b=NULL, void *c=NULL, void *d=NULL)
+{
+    if (!capturing) return;
+    void *h[4] = {a, b, c, d};
+    for (int i = 0; i < 4; i++) {
+        if (h[i] && capturing->handles.count(h[i])) {
+            printf("This operation can not be recorded in a graph\n");
             exit(-1);
         }
     }
+}
+
+void vec_add(void *dst, void *in1=NULL, void *in2=NULL, void *in3=NULL,
+             bool recorded=false)
+{
+    if (capturing && !recorded) {
+        graph_check(in1, in2, in3);
+        graph_forget(dst);
+    }
+
+    void *left  = (getnode(in1) < 0) ? NULL : in1;
+    void *right = (getnode(in2) < 0) ? NULL : in2;
+    void *third = (getnode(in3) < 0) ? NULL : in3;
+    Node n = {dst, left, right, third, false};
+    vec.push_back(n);
+}
+
+// Runs fn on the inputs and, while a graph is being captured, records it
+void apply3(void **dst, void *in1, void *in2, void *in3, Op3 fn)
+{
+    static const array none;
+    *dst = (void *)new array();
+    fn(*(array *)*dst,
+       in1 ? *(array *)in1 : none,
+       in2 ? *(array *)in2 : none,
+       in3 ? *(array *)in3 : none);
+    vec_add(*dst, in1, in2, in3, true);
+
+    if (capturing) {
+        Step st;
+        st.in1 = graph_input(capturing, in1);
+        st.in2 = graph_input(capturing, in2);
+        st.in3 = graph_input(capturing, in3);
+        st.out = graph_slot(capturing, array(), true);
+        st.fn  = fn;
+        capturing->steps.push_back(st);
+        capturing->handles[*dst] = st.out;
+    }
+}
+
+void apply(void **dst, void *in1, void *in2, Op fn)
+{
+    apply3(dst, in1, in2, NULL,
+           [fn](array &out, const array &a, const array &b, const array &) {
+               fn(out, a, b);
+           });
+}
+
+// Same as apply, but fn updates the array in place
+void apply_inplace(void *dst, void *in, Op fn)
+{
+    array *out = (array *)dst;
+    fn(*out, *out, *(array *)in);
+
+    if (capturing) {
+        Step st;
+        st.in1 = graph_input(capturing, dst);
+        st.in2 = graph_input(capturing, in);
+        st.in3 = -1;
+        st.out = st.in1;
+        st.fn  = [fn](array &o, const array &a, const array &b, const array &) {
+            fn(o, a, b);
+        };
+        capturing->steps.push_back(st);
+    }
+}
+
+// -1, 0 or 1 like fortran, af::sign only flags the negative values
+array signum(const array &in)
+{
+    dtype ty = in.type();
+    return (in > 0).as(ty) - (in < 0).as(ty);
+}
 
-#define GEN(fn)                                     \
-    void af_arr_##fn##_(void **ptr, int *x,         \
-                        int *fty, int *err)         \
-    {                                               \
-        try {                                       \
-            dtype ty = (dtype)(*fty - 1);           \
-            *ptr = (void *)new array();             \
-            array *tmp = (array *)*ptr;             \
-            *tmp = fn(x[0], x[1], x[2], x[3], ty);  \
-            vec_add(*ptr);                          \
-        } catch (af::exception& ex) {               \
-            *err = 3;                               \
-            printf("%s\n", ex.what());              \
-            exit(-1);                               \
-        }                                           \
-    }                                               \
+// Same results as the fortran intrinsics. af::rem is fmod (sign of a),
+// modulo moves non zero remainders to the sign of b. Both stay JIT nodes.
+template<typename L, typename R> array fmod_trunc(const L &a, const R &b)
+{
+    return af::rem(a, b);
+}
+
+template<typename L, typename R> array fmod_floor(const L &a, const R &b)
+{
+    array r = af::rem(a, b);
+    array fix = (r != 0) && ((r < 0) != (b < 0));
+    return select(fix, r + b, r);
+}
+
+// Binary operators, shared by the array-array and the array-scalar entry points
+struct plus_op   { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l + r;  } };
+struct minus_op  { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l - r;  } };
+struct times_op  { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l * r;  } };
+struct div_op    { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l / r;  } };
+struct le_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l <= r; } };
+struct lt_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l < r;  } };
+struct ge_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l >= r; } };
+struct gt_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l > r;  } };
+struct eq_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l == r; } };
+struct ne_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l != r; } };
+struct and_op    { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l && r; } };
+struct or_op     { template<typename L, typename R> array operator()(const L &l, const R &r) const { return l || r; } };
+struct pow_op    { template<typename L, typename R> array operator()(const L &l, const R &r) const { return af::pow(l, r);   } };
+struct atan2_op  { template<typename L, typename R> array operator()(const L &l, const R &r) const { return af::atan2(l, r); } };
+struct hypot_op  { template<typename L, typename R> array operator()(const L &l, const R &r) const { return af::hypot(l, r); } };
+struct min_op    { template<typename L, typename R> array operator()(const L &l, const R &r) const { return af::min(l, r);   } };
+struct max_op    { template<typename L, typename R> array operator()(const L &l, const R &r) const { return af::max(l, r);   } };
+struct mod_op    { template<typename L, typename R> array operator()(const L &l, const R &r) const { return fmod_trunc(l, r); } };
+struct modulo_op { template<typename L, typename R> array operator()(const L &l, const R &r) const { return fmod_floor(l, r); } };
+
+// Implementations behind the extern "C" entry points. Each entry point is a
+// one line instantiation for a given element type or operation.
+template<typename T> void device_create(void **ptr, const T *a, const int *shape, int *err)
+{
+    try {
+        *ptr = (void *)new array(shape[0], shape[1], shape[2], shape[3], a);
+        vec_add(*ptr);
+    } catch (af::exception& ex) {
+        *err = 1;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
 
-    GEN(randu);
-    GEN(randn);
-    GEN(identity);
-#undef GEN
+// Arrays of another type (index outputs are s32) are converted on the device first
+template<typename T> void host_copy(T *a, void *ptr, int *err)
+{
+    try {
+        array *in = (array *)ptr;
+        dtype ty = (dtype)dtype_traits<T>::af_type;
+        if (in->type() == ty) in->host((void *)a);
+        else in->as(ty).host((void *)a);
+    } catch (af::exception& ex) {
+        *err = 5;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
 
-void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
+template<typename F> void generate(void **ptr, const int *x, int fty, F fn, int *err)
 {
     try {
-        dtype ty = (dtype)(*fty - 1);
-        *ptr = (void *)new array();
-        array *tmp = (array *)*ptr;
-        *tmp = constant(*val, x[0], x[1], x[2], x[3], ty);
+        dim4 dims(x[0], x[1], x[2], x[3]);
+        *ptr = (void *)new array(fn(dims, (dtype)(fty - 1)));
         vec_add(*ptr);
     } catch (af::exception& ex) {
         *err = 3;
-        printf("%sn", ex.what());
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+// The scalar keeps its own type (float, double or int), ArrayFire then picks
+// the type of the constant from the array so f32 arrays stay in f32.
+// rev puts the scalar on the left hand side.
+template<typename Op, typename T> void binary_scalar(void **dst, void *src, T val, int rev,
+                                                     Op op, int *err)
+{
+    try {
+        bool r = (rev != 0);
+        apply(dst, src, NULL,
+              [=](array &out, const array &in, const array &) {
+                  out = r ? op(val, in) : op(in, val);
+              });
+    } catch (af::exception& ex) {
+        *err = 6;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+template<typename Op> void binary(void **dst, void *lhs, void *rhs, Op op, int *err)
+{
+    try {
+        apply(dst, lhs, rhs,
+              [=](array &out, const array &left, const array &right) {
+                  out = op(left, right);
+              });
+    } catch (af::exception& ex) {
+        *err = 7;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+template<typename F> void unary(void **dst, void *src, F fn, int *err)
+{
+    try {
+        apply(dst, src, NULL,
+              [=](array &out, const array &in, const array &) {
+                  out = fn(in);
+              });
+    } catch (af::exception& ex) {
+        *err = 10;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+// dim is 1-based, as in fortran
+template<typename F> void reduce(void **dst, void *src, int dim, F fn, int *err)
+{
+    try {
+        int d = dim - 1;
+        apply(dst, src, NULL,
+              [=](array &out, const array &in, const array &) {
+                  out = fn(in, d);
+              });
+    } catch (af::exception& ex) {
+        *err = 10;
+        printf("%s\n", ex.what());
         exit(-1);
     }
 }
 
-#define HOST(X, ty)                                                     \
-  void af_arr_host_##X##_(ty *a, void **ptr,                            \
-                          int *dim, int *err)                           \
-  {   try {                                                             \
-      array tmp = *(array *)*ptr;                                       \
-      dim4 d = tmp.dims();                                              \
-      int bytes = tmp.elements() * sizeof(ty);                          \
-      tmp.host((void *)a);                                              \
-    } catch (af::exception& ex) {                                       \
-      *err = 5;                                                         \
-      printf("%s\n", ex.what());                                        \
-      exit(-1);                                                         \
-    }                                                                   \
-  }                                                                     \
-
-    HOST(s, float);
-    HOST(d, double);
-    HOST(c, cfloat);
-    HOST(z, cdouble);
-
-#define SCOP(fn, op)                                \
-    void af_arr_sc##fn##_(void **dst, void **src,   \
-                          double *a, int *err)      \
-    {                                               \
-        try {                                       \
-            *dst = (void *)new array();             \
-            array *in = (array *)*src;              \
-            array *out  = (array *)*dst;            \
-            *out = *in op *a;                       \
-            vec_add(*dst, *src);                    \
-        } catch (af::exception& ex) {               \
-            *err = 6;                               \
-            printf("%s\n", ex.what());              \
-            exit(-1);                               \
-        }                                           \
-    }                                               \
-
-    SCOP(plus  , +)
-    SCOP(minus , -)
-    SCOP(times , *)
-    SCOP(div   , /)
-    SCOP(le    , <=)
-    SCOP(lt    , < )
-    SCOP(ge    , >=)
-    SCOP(gt    , > )
-    SCOP(eq    , ==)
-    SCOP(ne    , !=)
-
-#define ELOP(fn, op)                                \
-    void af_arr_el##fn##_(void **dst, void **src,   \
-                          void **tsd, int *err)     \
-    {                                               \
-        try {                                       \
-            *dst = (void *)new array();             \
-            array *left = (array *)*src;            \
-            array *right = (array *)*tsd;           \
-            array *out  = (array *)*dst;            \
-            *out = *left op *right;                 \
-            vec_add(*dst, *src, *tsd);              \
-        } catch (af::exception& ex) {               \
-            *err = 7;                               \
-            printf("%s\n", ex.what());              \
-            exit(-1);                               \
-        }                                           \
-    }                                               \
-
-    ELOP(plus  , +)
-    ELOP(minus , -)
-    ELOP(times , *)
-    ELOP(div   , /)
-    ELOP(le    , <=)
-    ELOP(lt    , < )
-    ELOP(ge    , >=)
-    ELOP(gt    , > )
-    ELOP(eq    , ==)
-    ELOP(ne    , !=)
-    ELOP(and   , &&)
-    ELOP(or    , ||)
-
-    void af_arr_negate_(void **dst, void **src, int *err)
+// Subroutine outputs are named fortran arrays, they are not put in vec
+// (like lu / qr) so that the next assignment does not free them. An array the
+// output already holds is overwritten in place, like the graph_run outputs,
+// so calling the subroutine every time step does not leak device memory.
+array *output(void **ptr)
+{
+    if (*ptr == NULL) *ptr = (void *)new array();
+    graph_forget(*ptr);
+    return (array *)*ptr;
+}
+
+// Value and location of the extremum in one pass, indices are 1-based
+// and stored as s32 so that they can be passed straight back to get / set.
+// (f32 would only hold them exactly up to 2^24 elements.)
+template<typename F> void extremum(void **val, void **idx, void *src, int dim, F fn, int *err)
+{
+    try {
+        graph_check(src);
+        array v, i;
+        fn(v, i, *(array *)src, dim - 1);
+        *output(val) = v;
+        *output(idx) = (i + 1).as(s32);
+    } catch (af::exception& ex) {
+        *err = 10;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+template<typename F> void transform(void **dst, void *src, F fn, int *err)
+{
+    try {
+        *dst = (void *)new array(fn(*(array *)src));
+        vec_add(*dst, src);
+    } catch (af::exception& ex) {
+        *err = 13;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+// AF_CONV_AUTO lets ArrayFire pick spatial or frequency domain from the filter size
+template<typename F> void convolve(void **dst, void *src, void *flt, int expand, F fn, int *err)
+{
+    try {
+        convMode mode = expand ? AF_CONV_EXPAND : AF_CONV_DEFAULT;
+        *dst = (void *)new array(fn(*(array *)src, *(array *)flt, mode));
+        vec_add(*dst, src, flt);
+    } catch (af::exception& ex) {
+        *err = 13;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+// rev selects the scalar where cond is true
+template<typename T> void select_scalar(void **dst, void *cond, void *a, T val, int rev, int *err)
+{
+    try {
+        bool r = (rev != 0);
+        apply(dst, cond, a,
+              [=](array &out, const array &c, const array &l) {
+                  out = r ? select(c, val, l) : select(c, l, val);
+              });
+    } catch (af::exception& ex) {
+        *err = 9;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+template<typename T> void clamp_scalar(void **dst, void *src, T lo, T hi, int *err)
+{
+    try {
+        apply(dst, src, NULL,
+              [=](array &out, const array &in, const array &) {
+                  out = clamp(in, lo, hi);
+              });
+    } catch (af::exception& ex) {
+        *err = 9;
+        printf("%s\n", ex.what());
+        exit(-1);
+    }
+}
+
+// Backends requested from fortran are the af_backend values (cpu 1, cuda 2, opencl 4).
+// Unavailable backends fall back to the CPU backend so GPU-less machines still run.
+void backend_select(int b)
+{
+    int avail = getAvailableBackends();
+    if (!(avail & b)) {
+        printf("Requested backend is not available, using the CPU backend\n");
+        b = AF_BACKEND_CPU;
+    }
+    setBackend((Backend)b);
+}
+
+// AF_FORTRAN_BACKEND (cpu, opencl or cuda) selects the backend when the library is loaded
+struct backend_env {
+    backend_env()
     {
+        const char *env = getenv("AF_FORTRAN_BACKEND");
+        if (env == NULL) return;
         try {
-            *dst = (void *)new array();
-            array *in = (array *)*src;
-            array *out  = (array *)*dst;
-            *out = -(*in);
-            vec_add(*dst, *src);
+            if (!strcmp(env, "cpu"))    backend_select(AF_BACKEND_CPU);
+            if (!strcmp(env, "cuda"))   backend_select(AF_BACKEND_CUDA);
+            if (!strcmp(env, "opencl")) backend_select(AF_BACKEND_OPENCL);
         } catch (af::exception& ex) {
-            *err = 8;
+            printf("%s\n", ex.what());
+        }
+    }
+} backend_env_init;
+
+extern "C" {
+
+    // Inputs and scalars are passed by value, new arrays are returned through
+    // the handle pointers. The matching interfaces are in arrayfire.f90.
+
+    void af_backend_set(int b, int *err)
+    {
+        try {
+            backend_select(b);
+        } catch (af::exception& ex) {
+            *err = 16;
             printf("%s\n", ex.what());
             exit(-1);
         }
     }
 
-    void af_arr_not_(void **dst, void **src, int *err)
+    void af_backend_get(int *b) { *b = getActiveBackend(); return; }
+    void af_backend_count(int *n) { *n = getBackendCount(); return; }
+    void af_backend_available(int b, int *avail) { *avail = (getAvailableBackends() & b) != 0; return; }
+
+    void af_device_info() { af::info(); return; }
+    void af_device_get(int *n) { *n = getDevice(); return; }
+    void af_device_set(int n) { setDevice(n); return; }
+    void af_device_count(int *n) {*n = getDeviceCount(); return; }
+
+    void af_device_eval(void *arr) { af::eval(*(array *)arr); return; }
+    void af_device_sync() { af::sync(); return; }
+
+    void af_timer_start() { timer::start(); return; }
+    void af_timer_stop(double *elapsed) { *elapsed = timer::stop(); return; }
+
+    void af_arr_device_s(void **ptr, const float   *a, const int *shape, int *err) { device_create(ptr, a, shape, err); }
+    void af_arr_device_d(void **ptr, const double  *a, const int *shape, int *err) { device_create(ptr, a, shape, err); }
+    void af_arr_device_c(void **ptr, const cfloat  *a, const int *shape, int *err) { device_create(ptr, a, shape, err); }
+    void af_arr_device_z(void **ptr, const cdouble *a, const int *shape, int *err) { device_create(ptr, a, shape, err); }
+
+    void af_arr_copy(void **dst, void *src, int *err)
+    {
+        try {
+            if (*dst == src) return;
+            if (*dst) {
+                graph_forget(*dst);
+                delete (array *)*dst;
+            }
+            *dst = src;
+            cleanup(*dst);
+        } catch (af::exception& ex) {
+            *err = 2;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_randu(void **ptr, const int *x, int fty, int *err)
+    {
+        generate(ptr, x, fty, [](const dim4 &d, dtype ty) { return randu(d, ty); }, err);
+    }
+
+    void af_arr_randn(void **ptr, const int *x, int fty, int *err)
+    {
+        generate(ptr, x, fty, [](const dim4 &d, dtype ty) { return randn(d, ty); }, err);
+    }
+
+    void af_arr_identity(void **ptr, const int *x, int fty, int *err)
+    {
+        generate(ptr, x, fty, [](const dim4 &d, dtype ty) { return identity(d, ty); }, err);
+    }
+
+    void af_arr_constant(void **ptr, int val, const int *x, int fty, int *err)
+    {
+        generate(ptr, x, fty, [=](const dim4 &d, dtype ty) { return constant(val, d, ty); }, err);
+    }
+
+    void af_arr_host_s(float   *a, void *ptr, int dim, int *err) { host_copy(a, ptr, err); }
+    void af_arr_host_d(double  *a, void *ptr, int dim, int *err) { host_copy(a, ptr, err); }
+    void af_arr_host_c(cfloat  *a, void *ptr, int dim, int *err) { host_copy(a, ptr, err); }
+    void af_arr_host_z(cdouble *a, void *ptr, int dim, int *err) { host_copy(a, ptr, err); }
+
+    // Operations with a scalar, typed as float (_s), double (_d) or int (_i)
+    void af_arr_scplus_s(void **dst, void *src, float  val, int rev, int *err)   { binary_scalar(dst, src, val, rev, plus_op(), err); }
+    void af_arr_scplus_d(void **dst, void *src, double val, int rev, int *err)   { binary_scalar(dst, src, val, rev, plus_op(), err); }
+    void af_arr_scplus_i(void **dst, void *src, int    val, int rev, int *err)   { binary_scalar(dst, src, val, rev, plus_op(), err); }
+
+    void af_arr_scminus_s(void **dst, void *src, float  val, int rev, int *err)  { binary_scalar(dst, src, val, rev, minus_op(), err); }
+    void af_arr_scminus_d(void **dst, void *src, double val, int rev, int *err)  { binary_scalar(dst, src, val, rev, minus_op(), err); }
+    void af_arr_scminus_i(void **dst, void *src, int    val, int rev, int *err)  { binary_scalar(dst, src, val, rev, minus_op(), err); }
+
+    void af_arr_sctimes_s(void **dst, void *src, float  val, int rev, int *err)  { binary_scalar(dst, src, val, rev, times_op(), err); }
+    void af_arr_sctimes_d(void **dst, void *src, double val, int rev, int *err)  { binary_scalar(dst, src, val, rev, times_op(), err); }
+    void af_arr_sctimes_i(void **dst, void *src, int    val, int rev, int *err)  { binary_scalar(dst, src, val, rev, times_op(), err); }
+
+    void af_arr_scdiv_s(void **dst, void *src, float  val, int rev, int *err)    { binary_scalar(dst, src, val, rev, div_op(), err); }
+    void af_arr_scdiv_d(void **dst, void *src, double val, int rev, int *err)    { binary_scalar(dst, src, val, rev, div_op(), err); }
+    void af_arr_scdiv_i(void **dst, void *src, int    val, int rev, int *err)    { binary_scalar(dst, src, val, rev, div_op(), err); }
+
+    void af_arr_scpow_s(void **dst, void *src, float  val, int rev, int *err)    { binary_scalar(dst, src, val, rev, pow_op(), err); }
+    void af_arr_scpow_d(void **dst, void *src, double val, int rev, int *err)    { binary_scalar(dst, src, val, rev, pow_op(), err); }
+    void af_arr_scpow_i(void **dst, void *src, int    val, int rev, int *err)    { binary_scalar(dst, src, val, rev, pow_op(), err); }
+
+    void af_arr_scle_s(void **dst, void *src, float  val, int rev, int *err)     { binary_scalar(dst, src, val, rev, le_op(), err); }
+    void af_arr_scle_d(void **dst, void *src, double val, int rev, int *err)     { binary_scalar(dst, src, val, rev, le_op(), err); }
+    void af_arr_scle_i(void **dst, void *src, int    val, int rev, int *err)     { binary_scalar(dst, src, val, rev, le_op(), err); }
+
+    void af_arr_sclt_s(void **dst, void *src, float  val, int rev, int *err)     { binary_scalar(dst, src, val, rev, lt_op(), err); }
+    void af_arr_sclt_d(void **dst, void *src, double val, int rev, int *err)     { binary_scalar(dst, src, val, rev, lt_op(), err); }
+    void af_arr_sclt_i(void **dst, void *src, int    val, int rev, int *err)     { binary_scalar(dst, src, val, rev, lt_op(), err); }
+
+    void af_arr_scge_s(void **dst, void *src, float  val, int rev, int *err)     { binary_scalar(dst, src, val, rev, ge_op(), err); }
+    void af_arr_scge_d(void **dst, void *src, double val, int rev, int *err)     { binary_scalar(dst, src, val, rev, ge_op(), err); }
+    void af_arr_scge_i(void **dst, void *src, int    val, int rev, int *err)     { binary_scalar(dst, src, val, rev, ge_op(), err); }
+
+    void af_arr_scgt_s(void **dst, void *src, float  val, int rev, int *err)     { binary_scalar(dst, src, val, rev, gt_op(), err); }
+    void af_arr_scgt_d(void **dst, void *src, double val, int rev, int *err)     { binary_scalar(dst, src, val, rev, gt_op(), err); }
+    void af_arr_scgt_i(void **dst, void *src, int    val, int rev, int *err)     { binary_scalar(dst, src, val, rev, gt_op(), err); }
+
+    void af_arr_sceq_s(void **dst, void *src, float  val, int rev, int *err)     { binary_scalar(dst, src, val, rev, eq_op(), err); }
+    void af_arr_sceq_d(void **dst, void *src, double val, int rev, int *err)     { binary_scalar(dst, src, val, rev, eq_op(), err); }
+    void af_arr_sceq_i(void **dst, void *src, int    val, int rev, int *err)     { binary_scalar(dst, src, val, rev, eq_op(), err); }
+
+    void af_arr_scne_s(void **dst, void *src, float  val, int rev, int *err)     { binary_scalar(dst, src, val, rev, ne_op(), err); }
+    void af_arr_scne_d(void **dst, void *src, double val, int rev, int *err)     { binary_scalar(dst, src, val, rev, ne_op(), err); }
+    void af_arr_scne_i(void **dst, void *src, int    val, int rev, int *err)     { binary_scalar(dst, src, val, rev, ne_op(), err); }
+
+    void af_arr_scatan2_s(void **dst, void *src, float  val, int rev, int *err)  { binary_scalar(dst, src, val, rev, atan2_op(), err); }
+    void af_arr_scatan2_d(void **dst, void *src, double val, int rev, int *err)  { binary_scalar(dst, src, val, rev, atan2_op(), err); }
+    void af_arr_scatan2_i(void **dst, void *src, int    val, int rev, int *err)  { binary_scalar(dst, src, val, rev, atan2_op(), err); }
+
+    void af_arr_schypot_s(void **dst, void *src, float  val, int rev, int *err)  { binary_scalar(dst, src, val, rev, hypot_op(), err); }
+    void af_arr_schypot_d(void **dst, void *src, double val, int rev, int *err)  { binary_scalar(dst, src, val, rev, hypot_op(), err); }
+    void af_arr_schypot_i(void **dst, void *src, int    val, int rev, int *err)  { binary_scalar(dst, src, val, rev, hypot_op(), err); }
+
+    void af_arr_scmod_s(void **dst, void *src, float  val, int rev, int *err)    { binary_scalar(dst, src, val, rev, mod_op(), err); }
+    void af_arr_scmod_d(void **dst, void *src, double val, int rev, int *err)    { binary_scalar(dst, src, val, rev, mod_op(), err); }
+    void af_arr_scmod_i(void **dst, void *src, int    val, int rev, int *err)    { binary_scalar(dst, src, val, rev, mod_op(), err); }
+
+    void af_arr_scmodulo_s(void **dst, void *src, float  val, int rev, int *err) { binary_scalar(dst, src, val, rev, modulo_op(), err); }
+    void af_arr_scmodulo_d(void **dst, void *src, double val, int rev, int *err) { binary_scalar(dst, src, val, rev, modulo_op(), err); }
+    void af_arr_scmodulo_i(void **dst, void *src, int    val, int rev, int *err) { binary_scalar(dst, src, val, rev, modulo_op(), err); }
+
+    void af_arr_scmin_s(void **dst, void *src, float  val, int rev, int *err)    { binary_scalar(dst, src, val, rev, min_op(), err); }
+    void af_arr_scmin_d(void **dst, void *src, double val, int rev, int *err)    { binary_scalar(dst, src, val, rev, min_op(), err); }
+
+    void af_arr_scmax_s(void **dst, void *src, float  val, int rev, int *err)    { binary_scalar(dst, src, val, rev, max_op(), err); }
+    void af_arr_scmax_d(void **dst, void *src, double val, int rev, int *err)    { binary_scalar(dst, src, val, rev, max_op(), err); }
+
+    // Element wise operations on two arrays
+    void af_arr_elplus(void **dst, void *lhs, void *rhs, int *err)   { binary(dst, lhs, rhs, plus_op(), err); }
+    void af_arr_elminus(void **dst, void *lhs, void *rhs, int *err)  { binary(dst, lhs, rhs, minus_op(), err); }
+    void af_arr_eltimes(void **dst, void *lhs, void *rhs, int *err)  { binary(dst, lhs, rhs, times_op(), err); }
+    void af_arr_eldiv(void **dst, void *lhs, void *rhs, int *err)    { binary(dst, lhs, rhs, div_op(), err); }
+    void af_arr_elpow(void **dst, void *lhs, void *rhs, int *err)    { binary(dst, lhs, rhs, pow_op(), err); }
+    void af_arr_elle(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, le_op(), err); }
+    void af_arr_ellt(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, lt_op(), err); }
+    void af_arr_elge(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, ge_op(), err); }
+    void af_arr_elgt(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, gt_op(), err); }
+    void af_arr_eleq(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, eq_op(), err); }
+    void af_arr_elne(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, ne_op(), err); }
+    void af_arr_eland(void **dst, void *lhs, void *rhs, int *err)    { binary(dst, lhs, rhs, and_op(), err); }
+    void af_arr_elor(void **dst, void *lhs, void *rhs, int *err)     { binary(dst, lhs, rhs, or_op(), err); }
+    void af_arr_elatan2(void **dst, void *lhs, void *rhs, int *err)  { binary(dst, lhs, rhs, atan2_op(), err); }
+    void af_arr_elhypot(void **dst, void *lhs, void *rhs, int *err)  { binary(dst, lhs, rhs, hypot_op(), err); }
+    void af_arr_elmin(void **dst, void *lhs, void *rhs, int *err)    { binary(dst, lhs, rhs, min_op(), err); }
+    void af_arr_elmax(void **dst, void *lhs, void *rhs, int *err)    { binary(dst, lhs, rhs, max_op(), err); }
+    void af_arr_elmod(void **dst, void *lhs, void *rhs, int *err)    { binary(dst, lhs, rhs, mod_op(), err); }
+    void af_arr_elmodulo(void **dst, void *lhs, void *rhs, int *err) { binary(dst, lhs, rhs, modulo_op(), err); }
+
+    void af_arr_negate(void **dst, void *src, int *err)  { unary(dst, src, [](const array &in) { return -in; }, err); }
+    void af_arr_not(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return !in; }, err); }
+    void af_arr_sin(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::sin(in); }, err); }
+    void af_arr_cos(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::cos(in); }, err); }
+    void af_arr_tan(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::tan(in); }, err); }
+    void af_arr_asin(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::asin(in); }, err); }
+    void af_arr_acos(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::acos(in); }, err); }
+    void af_arr_atan(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::atan(in); }, err); }
+    void af_arr_sinh(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::sinh(in); }, err); }
+    void af_arr_cosh(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::cosh(in); }, err); }
+    void af_arr_tanh(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::tanh(in); }, err); }
+    void af_arr_asinh(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::asinh(in); }, err); }
+    void af_arr_acosh(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::acosh(in); }, err); }
+    void af_arr_atanh(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::atanh(in); }, err); }
+    void af_arr_log(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::log(in); }, err); }
+    void af_arr_log10(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::log10(in); }, err); }
+    void af_arr_log2(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::log2(in); }, err); }
+    void af_arr_log1p(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::log1p(in); }, err); }
+    void af_arr_abs(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::abs(in); }, err); }
+    void af_arr_exp(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::exp(in); }, err); }
+    void af_arr_expm1(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::expm1(in); }, err); }
+    void af_arr_sqrt(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::sqrt(in); }, err); }
+    void af_arr_cbrt(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::cbrt(in); }, err); }
+    void af_arr_erf(void **dst, void *src, int *err)     { unary(dst, src, [](const array &in) { return af::erf(in); }, err); }
+    void af_arr_erfc(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::erfc(in); }, err); }
+    void af_arr_tgamma(void **dst, void *src, int *err)  { unary(dst, src, [](const array &in) { return af::tgamma(in); }, err); }
+    void af_arr_lgamma(void **dst, void *src, int *err)  { unary(dst, src, [](const array &in) { return af::lgamma(in); }, err); }
+    void af_arr_floor(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::floor(in); }, err); }
+    void af_arr_ceil(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::ceil(in); }, err); }
+    void af_arr_round(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::round(in); }, err); }
+    void af_arr_trunc(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::trunc(in); }, err); }
+    void af_arr_iszero(void **dst, void *src, int *err)  { unary(dst, src, [](const array &in) { return af::iszero(in); }, err); }
+    void af_arr_sort(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::sort(in); }, err); }
+    void af_arr_upper(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::upper(in); }, err); }
+    void af_arr_lower(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::lower(in); }, err); }
+    void af_arr_diag(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::diag(in); }, err); }
+    void af_arr_real(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::real(in); }, err); }
+    void af_arr_imag(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return af::imag(in); }, err); }
+    void af_arr_complex(void **dst, void *src, int *err) { unary(dst, src, [](const array &in) { return af::complex(in); }, err); }
+    void af_arr_conjg(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return af::conjg(in); }, err); }
+    void af_arr_sign(void **dst, void *src, int *err)    { unary(dst, src, [](const array &in) { return signum(in); }, err); }
+    void af_arr_isnan(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return isNaN(in); }, err); }
+    void af_arr_isinf(void **dst, void *src, int *err)   { unary(dst, src, [](const array &in) { return isInf(in); }, err); }
+
+    void af_arr_select(void **dst, void *cond, void *a, void *b, int *err)
+    {
+        try {
+            apply3(dst, cond, a, b,
+                   [](array &out, const array &c, const array &l, const array &r) {
+                       out = select(c, l, r);
+                   });
+        } catch (af::exception& ex) {
+            *err = 9;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_scselect_s(void **dst, void *cond, void *a, float  val, int rev, int *err) { select_scalar(dst, cond, a, val, rev, err); }
+    void af_arr_scselect_d(void **dst, void *cond, void *a, double val, int rev, int *err) { select_scalar(dst, cond, a, val, rev, err); }
+
+    void af_arr_clamp(void **dst, void *src, void *lo, void *hi, int *err)
+    {
+        try {
+            apply3(dst, src, lo, hi,
+                   [](array &out, const array &in, const array &l, const array &h) {
+                       out = clamp(in, l, h);
+                   });
+        } catch (af::exception& ex) {
+            *err = 9;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_scclamp_s(void **dst, void *src, float  lo, float  hi, int *err) { clamp_scalar(dst, src, lo, hi, err); }
+    void af_arr_scclamp_d(void **dst, void *src, double lo, double hi, int *err) { clamp_scalar(dst, src, lo, hi, err); }
+
+    void af_arr_sum    (void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return sum(in, d);     }, err); }
+    void af_arr_product(void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return product(in, d); }, err); }
+    void af_arr_min    (void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return min(in, d);     }, err); }
+    void af_arr_max    (void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return max(in, d);     }, err); }
+    void af_arr_mean   (void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return mean(in, d);    }, err); }
+    void af_arr_stdev  (void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return stdev(in, d);   }, err); }
+    void af_arr_var    (void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return var(in, false, d); }, err); }
+    void af_arr_anytrue(void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return anyTrue(in, d); }, err); }
+    void af_arr_alltrue(void **dst, void *src, int dim, int *err) { reduce(dst, src, dim, [](const array &in, int d) { return allTrue(in, d); }, err); }
+
+    void af_arr_imin(void **val, void **idx, void *src, int dim, int *err)
+    {
+        extremum(val, idx, src, dim, [](array &v, array &i, const array &in, int d) { min(v, i, in, d); }, err);
+    }
+
+    void af_arr_imax(void **val, void **idx, void *src, int dim, int *err)
+    {
+        extremum(val, idx, src, dim, [](array &v, array &i, const array &in, int d) { max(v, i, in, d); }, err);
+    }
+
+    // Two reductions, ArrayFire has no fused min / max kernel
+    void af_arr_minmax(void **mn, void **mx, void *src, int dim, int *err)
+    {
+        try {
+            graph_check(src);
+            array *in = (array *)src;
+            array lo = min(*in, (dim - 1));
+            array hi = max(*in, (dim - 1));
+            *output(mn) = lo;
+            *output(mx) = hi;
+        } catch (af::exception& ex) {
+            *err = 10;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_mean_var(void **mu, void **s2, void *src, int dim, int *err)
+    {
+        try {
+            graph_check(src);
+            array *in = (array *)src;
+            array m, v;
+            meanvar(m, v, *in, array(), AF_VARIANCE_SAMPLE, (dim - 1));
+            *output(mu) = m;
+            *output(s2) = v;
+        } catch (af::exception& ex) {
+            *err = 10;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    // Index outputs below are 1-based and stored as s32, same as imin / imax.
+    void af_arr_sort_index(void **out, void **idx, void *src,
+                           int dim, int asc, int *err)
+    {
+        try {
+            graph_check(src);
+            array *in = (array *)src;
+            array o, i;
+            sort(o, i, *in, (dim - 1), (asc != 0));
+            *output(out) = o;
+            *output(idx) = (i + 1).as(s32);
+        } catch (af::exception& ex) {
+            *err = 14;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_sort_by_key(void **okeys, void **ovals, void *keys, void *vals,
+                            int dim, int asc, int *err)
+    {
+        try {
+            graph_check(keys, vals);
+            array *K = (array *)keys, *V = (array *)vals;
+            array ok, ov;
+            sort(ok, ov, *K, *V, (dim - 1), (asc != 0));
+            *output(okeys) = ok;
+            *output(ovals) = ov;
+        } catch (af::exception& ex) {
+            *err = 14;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_topk(void **val, void **idx, void *src,
+                     int k, int largest, int *err)
+    {
+        try {
+            graph_check(src);
+            array *in = (array *)src;
+            array v, i;
+            topk(v, i, *in, k, 0, largest ? AF_TOPK_MAX : AF_TOPK_MIN);
+            *output(val) = v;
+            *output(idx) = (i + 1).as(s32);
+        } catch (af::exception& ex) {
+            *err = 14;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_where(void **dst, void *src, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *in = (array *)*src;
+            array *in = (array *)src;
             array *out  = (array *)*dst;
-            *out = !(*in);
-            vec_add(*dst, *src);
+            *out = (where(*in) + 1).as(s32);
+            vec_add(*dst, src);
         } catch (af::exception& ex) {
-            *err = 8;
+            *err = 14;
             printf("%s\n", ex.what());
             exit(-1);
         }
     }
 
-    void af_arr_scpow_(void **dst, void **src, double *a, int *err)
+    void af_arr_scan(void **dst, void *src, int dim, int inclusive, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *in = (array *)*src;
+            array *in = (array *)src;
             array *out  = (array *)*dst;
-            *out = pow(*in , *a);
-            vec_add(*dst, *src);
+            *out = scan(*in, (dim - 1), AF_BINARY_ADD, (inclusive != 0));
+            vec_add(*dst, src);
         } catch (af::exception& ex) {
-            *err = 8;
+            *err = 14;
             printf("%s\n", ex.what());
             exit(-1);
         }
     }
 
-    void af_arr_elpow_(void **dst, void **src, void **tsd, int *err)
+    // Plans are cached per shape by the backend, this only controls how many are kept.
+    void af_fft_plan_cache(int n) { setFFTPlanCacheSize(n); return; }
+
+    void af_arr_fft  (void **dst, void *src, int *err) { transform(dst, src, [](const array &in) { return fft(in);   }, err); }
+    void af_arr_ifft (void **dst, void *src, int *err) { transform(dst, src, [](const array &in) { return ifft(in);  }, err); }
+    void af_arr_fft2 (void **dst, void *src, int *err) { transform(dst, src, [](const array &in) { return fft2(in);  }, err); }
+    void af_arr_ifft2(void **dst, void *src, int *err) { transform(dst, src, [](const array &in) { return ifft2(in); }, err); }
+    void af_arr_fft3 (void **dst, void *src, int *err) { transform(dst, src, [](const array &in) { return fft3(in);  }, err); }
+    void af_arr_ifft3(void **dst, void *src, int *err) { transform(dst, src, [](const array &in) { return ifft3(in); }, err); }
+
+    void af_arr_fftr2c(void **dst, void *src, int rank, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *left = (array *)*src;
-            array *right = (array *)*tsd;
+            array *in = (array *)src;
             array *out  = (array *)*dst;
-            *out = pow(*left , *right);
-            vec_add(*dst, *src, *tsd);
+            switch (rank) {
+            case 1: *out = fftR2C<1>(*in); break;
+            case 2: *out = fftR2C<2>(*in); break;
+            case 3: *out = fftR2C<3>(*in); break;
+            default:
+                printf("fftr2c: rank should be 1, 2 or 3\n");
+                exit(-1);
+            }
+            vec_add(*dst, src);
         } catch (af::exception& ex) {
-            *err = 9;
+            *err = 13;
             printf("%s\n", ex.what());
             exit(-1);
         }
     }
 
-#define OP(fn)                                  \
-    void af_arr_##fn##_(void **dst, void **src, \
-                        int *err)               \
-    {                                           \
-        try {                                   \
-            *dst = (void *)new array();         \
-            array *in = (array *)*src;          \
-            array *out  = (array *)*dst;        \
-            *out = af::fn(*in);                 \
-            vec_add(*dst, *src);                \
-        } catch (af::exception& ex) {           \
-            *err = 10;                          \
-            printf("%s\n", ex.what());          \
-            exit(-1);                           \
-        }                                       \
-    }                                           \
-
-    OP(sin);
-    OP(cos);
-    OP(tan);
-    OP(log);
-    OP(abs);
-    OP(exp);
-    OP(sort);
-    OP(upper);
-    OP(lower);
-    OP(diag);
-    OP(real);
-    OP(imag);
-    OP(complex);
-    OP(conjg);
-    OP(mean);
-    OP(var);
-    OP(stdev);
-
-#undef OP
-
-#define OP_NAME(fn, afn)                        \
-    void af_arr_##fn##_(void **dst, void **src, \
-                        int *dim, int *err)     \
-    {                                           \
-        try {                                   \
-            *dst = (void *)new array();         \
-            array *in = (array *)*src;          \
-            array *out  = (array *)*dst;        \
-            *out = afn(*in, (*dim - 1));        \
-            vec_add(*dst, *src);                \
-        } catch (af::exception& ex) {           \
-            *err = 10;                          \
-            printf("%s\n", ex.what());          \
-            exit(-1);                           \
-        }                                       \
-    }                                           \
-
-#define OP(fn) OP_NAME(fn, fn)
-
-    OP(sum);
-    OP(product);
-    OP(min);
-    OP(max);
-
-    OP_NAME(anytrue, anyTrue);
-    OP_NAME(alltrue, allTrue);
-
-#undef OP_NAME
-#undef OP
-
-    void af_arr_moddims_(void **dst, void **src, int *x, int *err)
+    void af_arr_fftc2r(void **dst, void *src, int rank, int odd, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *in = (array *)*src;
+            array *in = (array *)src;
             array *out  = (array *)*dst;
-            *out = moddims(*in, x[0], x[1], x[2], x[3]);
-            vec_add(*dst, *src);
+            bool is_odd = (odd != 0);
+            switch (rank) {
+            case 1: *out = fftC2R<1>(*in, is_odd); break;
+            case 2: *out = fftC2R<2>(*in, is_odd); break;
+            case 3: *out = fftC2R<3>(*in, is_odd); break;
+            default:
+                printf("fftc2r: rank should be 1, 2 or 3\n");
+                exit(-1);
+            }
+            vec_add(*dst, src);
+        } catch (af::exception& ex) {
+            *err = 13;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_convolve1(void **dst, void *src, void *flt, int expand, int *err)
+    {
+        convolve(dst, src, flt, expand, [](const array &s, const array &f, convMode m) {
+                return convolve1(s, f, m, AF_CONV_AUTO);
+            }, err);
+    }
+
+    void af_arr_convolve2(void **dst, void *src, void *flt, int expand, int *err)
+    {
+        convolve(dst, src, flt, expand, [](const array &s, const array &f, convMode m) {
+                return convolve2(s, f, m, AF_CONV_AUTO);
+            }, err);
+    }
+
+    void af_arr_convolve3(void **dst, void *src, void *flt, int expand, int *err)
+    {
+        convolve(dst, src, flt, expand, [](const array &s, const array &f, convMode m) {
+                return convolve3(s, f, m, AF_CONV_AUTO);
+            }, err);
+    }
+
+
+    void af_arr_moddims(void **dst, void *src, const int *x, int *err)
+    {
+        try {
+            dim4 dims(x[0], x[1], x[2], x[3]);
+            apply(dst, src, NULL,
+                  [=](array &out, const array &in, const array &) {
+                      out = moddims(in, dims);
+                  });
         } catch (af::exception& ex) {
             *err = 11;
             printf("%sn", ex.what());
@@ -370,15 +928,14 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_tile_(void **dst, void **src, int *x, int *err)
+    void af_arr_tile(void **dst, void *src, const int *x, int *err)
     {
         try {
-            *dst = (void *)new array();
-            array *in = (array *)*src;
-            array *out  = (array *)*dst;
             dim4 dims(x[0], x[1], x[2], x[3]);
-            *out = tile(*in, dims);
-            vec_add(*dst, *src);
+            apply(dst, src, NULL,
+                  [=](array &out, const array &in, const array &) {
+                      out = tile(in, dims);
+                  });
         } catch (af::exception& ex) {
             *err = 11;
             printf("%sn", ex.what());
@@ -386,14 +943,114 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_t_(void **dst, void **src, int *err)
+    // boundary: 1 periodic, 2 clamped to the edge
+    void af_arr_shift(void **dst, void *src, const int *x, int boundary, int *err)
     {
         try {
-            *dst = (void *)new array();
-            array *in = (array *)*src;
-            array *out  = (array *)*dst;
-            *out = (*in).T();
-            vec_add(*dst, *src);
+            if (boundary != 1 && boundary != 2) {
+                printf("shift: boundary should be af_periodic or af_clamped\n");
+                exit(-1);
+            }
+
+            int sx[4] = {x[0], x[1], x[2], x[3]};
+            bool clamp = (boundary == 2);
+            apply(dst, src, NULL,
+                  [=](array &out, const array &in, const array &) {
+                      if (!clamp) {
+                          out = shift(in, sx[0], sx[1], sx[2], sx[3]);
+                          return;
+                      }
+                      dim4 d = in.dims(), lo, hi;
+                      seq s[4] = {span, span, span, span};
+                      for (int i = 0; i < 4; i++) {
+                          lo[i] = sx[i] > 0 ?  sx[i] : 0;
+                          hi[i] = sx[i] < 0 ? -sx[i] : 0;
+                          s[i] = seq(lo[i] - sx[i], lo[i] - sx[i] + d[i] - 1);
+                      }
+                      array P = pad(in, lo, hi, AF_PAD_CLAMP_TO_EDGE);
+                      out = P(s[0], s[1], s[2], s[3]);
+                  });
+        } catch (af::exception& ex) {
+            *err = 11;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    // Every point of the stencil is a lazy view of the input, so the weighted
+    // sum is a single JIT expression. Periodic points are shifts of the input,
+    // clamped points are views into the input padded once with its edges.
+    // offs is a column major (ndim x npts) array of offsets.
+    void af_arr_stencil(void **dst, void *src, const int *offs, int ndim,
+                        const double *w, int npts, int boundary, int *err)
+    {
+        try {
+            if (ndim < 1 || ndim > 4 || npts < 1) {
+                printf("stencil: offsets should be of size (1..4, number of weights)\n");
+                exit(-1);
+            }
+
+            if (boundary != 1 && boundary != 2) {
+                printf("stencil: boundary should be af_periodic or af_clamped\n");
+                exit(-1);
+            }
+
+            int nd = ndim, np = npts;
+            vector<int> off(offs, offs + nd * np);
+            vector<double> wt(w, w + np);
+            bool clamp = (boundary == 2);
+
+            apply(dst, src, NULL,
+                  [=](array &out, const array &in, const array &) {
+                      if (!clamp) {
+                          array acc;
+                          for (int k = 0; k < np; k++) {
+                              int sx[4] = {0, 0, 0, 0};
+                              for (int i = 0; i < nd; i++) sx[i] = -off[k * nd + i];
+                              array term = wt[k] * shift(in, sx[0], sx[1], sx[2], sx[3]);
+                              acc = (k == 0) ? term : acc + term;
+                          }
+                          out = acc;
+                          return;
+                      }
+
+                      dim4 d = in.dims(), lo(0, 0, 0, 0), hi(0, 0, 0, 0);
+                      for (int k = 0; k < np; k++) {
+                          for (int i = 0; i < nd; i++) {
+                              int o = off[k * nd + i];
+                              if (-o > lo[i]) lo[i] = -o;
+                              if ( o > hi[i]) hi[i] =  o;
+                          }
+                      }
+
+                      array P = pad(in, lo, hi, AF_PAD_CLAMP_TO_EDGE);
+
+                      array acc;
+                      for (int k = 0; k < np; k++) {
+                          seq s[4] = {span, span, span, span};
+                          for (int i = 0; i < nd; i++) {
+                              int o = off[k * nd + i];
+                              s[i] = seq(lo[i] + o, lo[i] + o + d[i] - 1);
+                          }
+                          array term = wt[k] * P(s[0], s[1], s[2], s[3]);
+                          acc = (k == 0) ? term : acc + term;
+                      }
+                      out = acc;
+                  });
+        } catch (af::exception& ex) {
+            *err = 11;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_t(void **dst, void *src, int *err)
+    {
+        try {
+            apply(dst, src, NULL,
+                  [](array &out, const array &in, const array &) {
+                      out = in.T();
+                  });
         } catch (af::exception& ex) {
             *err = 11;
             printf("%s\n", ex.what());
@@ -401,14 +1058,14 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_h_(void **dst, void **src, int *err)
+    void af_arr_h(void **dst, void *src, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *in = (array *)*src;
+            array *in = (array *)src;
             array *out  = (array *)*dst;
             *out = (*in).H();
-            vec_add(*dst, *src);
+            vec_add(*dst, src);
         } catch (af::exception& ex) {
             *err = 11;
             printf("%s\n", ex.what());
@@ -416,14 +1073,14 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_reorder_(void **dst, void **src, int *shape, int *err)
+    void af_arr_reorder(void **dst, void *src, const int *shape, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *in = (array *)*src;
+            array *in = (array *)src;
             array *out  = (array *)*dst;
             *out = reorder(*in, shape[0]-1, shape[1]-1, shape[2]-1, shape[3]-1);
-            vec_add(*dst, *src);
+            vec_add(*dst, src);
         } catch (af::exception& ex) {
             *err = 11;
             printf("%s\n", ex.what());
@@ -431,15 +1088,15 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_complex2_(void **dst, void **re, void **im, int *err)
+    void af_arr_complex2(void **dst, void *re, void *im, int *err)
     {
         try {
             *dst = (void *)new array();
-            array *in1 = (array *)*re;
-            array *in2 = (array *)*im;
+            array *in1 = (array *)re;
+            array *in2 = (array *)im;
             array *out  = (array *)*dst;
             *out = af::complex(*in1, *in2);
-            vec_add(*dst, *re, *im);
+            vec_add(*dst, re, im);
         } catch (af::exception& ex) {
             *err = 11;
             printf("%s\n", ex.what());
@@ -447,10 +1104,11 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_norm_(double *dst, void **src, int *err)
+    void af_arr_norm(double *dst, void *src, int *err)
     {
         try {
-            array *in = (array *)*src;
+            graph_check(src);
+            array *in = (array *)src;
             *dst = (double)norm(*in);
         } catch (af::exception& ex) {
             *err = 11;
@@ -459,11 +1117,12 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_pnorm_(double *dst, void **src, float *p, int *err)
+    void af_arr_pnorm(double *dst, void *src, float p, int *err)
     {
         try {
-            array *in = (array *)*src;
-            *dst = (double)norm(*in, AF_NORM_VECTOR_P, *p);
+            graph_check(src);
+            array *in = (array *)src;
+            *dst = (double)norm(*in, AF_NORM_VECTOR_P, p);
         } catch (af::exception& ex) {
             *err = 11;
             printf("%s\n", ex.what());
@@ -471,16 +1130,13 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_matmul_(void **dst, void **src, void **tsd, int *err)
+    void af_arr_matmul(void **dst, void *lhs, void *rhs, int *err)
     {
         try {
-
-            *dst = (void *)new array();
-            array *left = (array *)*src;
-            array *right = (array *)*tsd;
-            array *out  = (array *)*dst;
-            *out = matmul(*left, *right);
-            vec_add(*dst, *src, *tsd);
+            apply(dst, lhs, rhs,
+                  [](array &out, const array &left, const array &right) {
+                      out = matmul(left, right);
+                  });
         } catch (af::exception& ex) {
             *err = 11;
             printf("%s\n", ex.what());
@@ -488,14 +1144,18 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_lu_(void **l, void **u, void **p, void **in, int *err)
+    void af_arr_lu(void **l, void **u, void **p, void *in, int *err)
     {
         try {
+            graph_check(in);
             *l = (void *)new array();
             *u = (void *)new array();
             *p = (void *)new array();
+            graph_forget(*l);
+            graph_forget(*u);
+            graph_forget(*p);
 
-            array *L = (array *)*l, *U = (array *)*u, *P = (array *)*p, *A = (array *)*in;
+            array *L = (array *)*l, *U = (array *)*u, *P = (array *)*p, *A = (array *)in;
             lu(*L, *U, *P, *A);
         }
         catch (af::exception& ex) {
@@ -506,10 +1166,11 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
     }
 
 
-    void af_arr_lu_inplace_(void **in, int *err)
+    void af_arr_lu_inplace(void *in, int *err)
     {
         try {
-            array *A = (array *)*in;
+            graph_check(in);
+            array *A = (array *)in;
             int m = A->dims(0), n = A->dims(1);
             array pivot;
             luInPlace(pivot, *A, true);
@@ -522,13 +1183,16 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
     }
 
 
-    void af_arr_qr_(void **q, void **r, void **in, int *err)
+    void af_arr_qr(void **q, void **r, void *in, int *err)
     {
         try {
+            graph_check(in);
             *q = (void *)new array();
             *r = (void *)new array();
+            graph_forget(*q);
+            graph_forget(*r);
 
-            array *Q = (array *)*q, *R = (array *)*r, *A = (array *)*in;
+            array *Q = (array *)*q, *R = (array *)*r, *A = (array *)in;
             qr(*Q, *R, *A);
         }
         catch (af::exception& ex) {
@@ -539,12 +1203,14 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
     }
 
 
-    void af_arr_cholesky_(void **r, void **in, int *err)
+    void af_arr_cholesky(void **r, void *in, int *err)
     {
         try {
+            graph_check(in);
             *r = (void *)new array();
+            graph_forget(*r);
             unsigned info;
-            array *R = (array *)*r, *A = (array *)*in;
+            array *R = (array *)*r, *A = (array *)in;
             *err = cholesky(*R, *A, false);
         }
         catch (af::exception& ex) {
@@ -555,11 +1221,12 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
     }
 
 
-    void af_arr_cholesky_inplace_(void **r, int *err)
+    void af_arr_cholesky_inplace(void *r, int *err)
     {
         try {
+            graph_check(r);
             unsigned info;
-            array *R = (array *)*r;
+            array *R = (array *)r;
             *err = choleskyInPlace(*R, true);
         }
         catch (af::exception& ex) {
@@ -569,14 +1236,18 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_singular_(void **s, void **u, void **v, void **in, int *err)
+    void af_arr_singular(void **s, void **u, void **v, void *in, int *err)
     {
         try {
+            graph_check(in);
             *s = (void *)new array();
             *u = (void *)new array();
             *v = (void *)new array();
+            graph_forget(*s);
+            graph_forget(*u);
+            graph_forget(*v);
 
-            array *S = (array *)*s, *U = (array *)*u, *V = (array *)*v, *A = (array *)*in;
+            array *S = (array *)*s, *U = (array *)*u, *V = (array *)*v, *A = (array *)in;
             svd(*S, *U, *V, *A);
         }
         catch (af::exception& ex) {
@@ -586,13 +1257,13 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         *err = 0;
     }
 
-    void af_arr_inverse_(void **r, void **in, int *err)
+    void af_arr_inverse(void **r, void *in, int *err)
     {
         try {
             *r = (void *)new array();
-            array *R = (array *)*r, *A = (array *)*in;
+            array *R = (array *)*r, *A = (array *)in;
             *R = inverse(*A);
-            vec_add((void *)r, *in);
+            vec_add(*r, in);
         }
         catch (af::exception& ex) {
             *err = 11;
@@ -601,14 +1272,14 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_solve_(void **x, void **a, void **b, int *err)
+    void af_arr_solve(void **x, void *a, void *b, int *err)
     {
         try {
             *x = (void *)new array();
 
-            array *A = (array *)*a, *B = (array *)*b, *X = (array *)*x;
+            array *A = (array *)a, *B = (array *)b, *X = (array *)*x;
             *X = solve(*A, *B);
-            vec_add(*x, *a, *b);
+            vec_add(*x, a, b);
         }
         catch (af::exception& ex) {
             *err = 11;
@@ -617,36 +1288,109 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_get_(void **out, void **in,
-                     void **d0, void **d1, int *d2, int *d3, int *dims,
-                     int *err)
+    // Factorize in single precision, refine the residual in the input precision.
+    // iter > 0 is the number of residual evaluations until convergence, so 1
+    // means the single precision solution needed no correction. 0 means no
+    // refinement was attempted (single precision input or non square A) and
+    // < 0 means refinement did not converge. In both cases the result comes
+    // from solve in the input precision. res is the relative residual of the
+    // returned solution, |B - A X| / (|A| |X|), on every path.
+    void af_arr_solve_refined(void **x, void *a, void *b,
+                              double tol, int maxit,
+                              int *iter, double *res, int *err)
+    {
+        try {
+            graph_check(a, b);
+            *x = (void *)new array();
+
+            array *A = (array *)a, *B = (array *)b, *X = (array *)*x;
+            dtype ty = A->type();
+
+            double anrm = norm(*A);
+            auto resid = [&]() {
+                double den = anrm * norm(*X);
+                double r = norm(*B - matmul(*A, *X));
+                return (den > 0) ? r / den : r;
+            };
+
+            *iter = 0;
+
+            if ((ty != f64 && ty != c64) || A->dims(0) != A->dims(1)) {
+                *X = solve(*A, *B);
+                *res = resid();
+                vec_add(*x, a, b);
+                return;
+            }
+
+            dtype lo = (ty == c64) ? c32 : f32;
+
+            array LU = A->as(lo);
+            array piv;
+            luInPlace(piv, LU, true);
+
+            *X = solveLU(LU, piv, B->as(lo)).as(ty);
+
+            int it = 0;
+            for (;;) {
+                array R = *B - matmul(*A, *X);
+                double den = anrm * norm(*X);
+                *res = (den > 0) ? norm(R) / den : norm(R);
+                it++;
+                if (*res <= tol || *res != *res || it > maxit) break;
+                *X += solveLU(LU, piv, R.as(lo)).as(ty);
+            }
+
+            if (*res <= tol) {
+                *iter = it;
+            } else {
+                *X = solve(*A, *B);
+                *res = resid();
+                *iter = -it;
+            }
+
+            vec_add(*x, a, b);
+        }
+        catch (af::exception& ex) {
+            *err = 11;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_arr_get(void **out, void *in,
+                    void *d0, void *d1, const int *d2, const int *d3, int dims,
+                    int *err)
     {
         try {
+            graph_check(d0, (dims >= 2) ? d1 : NULL);
             *out = (void *)new array();
             array *R = (array *)*out;
-            array A = *(array *)*in;
-
-            array idx0 = (*(array *)*d0) - 1;
-            array idx1 = array(A.dims(1));
-            seq idx2 = span;
-            int idx3 = 0;
+            array A = *(array *)in;
 
-            if (*dims >= 2) idx1 = (*(array *)*d1) - 1;
-            if (*dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
-            if (*dims >= 4) idx3 = d3[0];
+            array idx0 = (*(array *)d0) - 1;
 
-            if (*dims == 3) {
-                *R = A(idx0, idx1, idx2);
+            // A single index array holds linear indices (e.g. from where)
+            if (dims == 1) {
+                *R = A(idx0);
             } else {
-                if (d2[0] != d2[1]) {
-                    printf("When using 4d indexing, last two dimensions should be integers\n");
-                    exit(-1);
+                array idx1 = (*(array *)d1) - 1;
+                seq idx2 = span;
+
+                if (dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
+
+                if (dims <= 3) {
+                    *R = A(idx0, idx1, idx2);
+                } else {
+                    if (d2[0] != d2[1]) {
+                        printf("When using 4d indexing, last two dimensions should be integers\n");
+                        exit(-1);
+                    }
+                    int lastdim = d3[0] * A.dims(2) + d2[0];
+                    *R = A(idx0, idx1, lastdim);
                 }
-                int lastdim = idx3 * A.dims(2) + d2[0];
-                *R = A(idx0, idx1, lastdim);
             }
 
-            vec_add(*out, *in);
+            vec_add(*out, in);
         } catch (af::exception& ex) {
             *err = 12;
             printf("%s\n", ex.what());
@@ -654,24 +1398,25 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_get2_(void **out, void **in,
-                      void **d0, int *d1, int *d2, int *dims,
-                      int *err)
+    void af_arr_get2(void **out, void *in,
+                     void *d0, const int *d1, const int *d2, int dims,
+                     int *err)
     {
         try {
+            graph_check(d0);
             *out = (void *)new array();
             array *R = (array *)*out;
-            array A = *(array *)*in;
+            array A = *(array *)in;
 
-            array idx0 = (*(array *)*d0) - 1;
+            array idx0 = (*(array *)d0) - 1;
             seq idx1 = span;
             seq idx2 = span;
 
-            if (*dims >= 2) idx1 = seq(d1[0], d1[2], d1[1]);
-            if (*dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
+            if (dims >= 2) idx1 = seq(d1[0], d1[2], d1[1]);
+            if (dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
 
             *R = A(idx0, idx1, idx2);
-            vec_add(*out, *in);
+            vec_add(*out, in);
 
         } catch (af::exception& ex) {
             *err = 12;
@@ -680,27 +1425,24 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_get_seq_(void **out, void **in,
-                         int *d0, int *d1, int *d2, int *d3,
-                         int *dim, int *err)
+    void af_arr_get_seq(void **out, void *in,
+                        const int *d0, const int *d1, const int *d2, const int *d3,
+                        int dim, int *err)
     {
         try {
-            *out = (void *)new array();
-            array *R = (array *)*out;
-            array A = *(array *)*in;
-
             seq s0 = seq(d0[0], d0[2], d0[1]);
             seq s1 = span;
             seq s2 = span;
             seq s3 = span;
 
-            if (*dim >= 2) s1 = seq(d1[0], d1[2], d1[1]);
-            if (*dim >= 3) s2 = seq(d2[0], d2[2], d2[1]);
-            if (*dim >= 4) s3 = seq(d3[0], d3[2], d3[1]);
-
-            *R = A(s0, s1, s2, s3);
+            if (dim >= 2) s1 = seq(d1[0], d1[2], d1[1]);
+            if (dim >= 3) s2 = seq(d2[0], d2[2], d2[1]);
+            if (dim >= 4) s3 = seq(d3[0], d3[2], d3[1]);
 
-            vec_add(*out, *in);
+            apply(out, in, NULL,
+                  [=](array &R, const array &A, const array &) {
+                      R = A(s0, s1, s2, s3);
+                  });
         } catch (af::exception& ex) {
             *err = 12;
             printf("%s\n", ex.what());
@@ -708,32 +1450,36 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_set_(void **out, void **in,
-                     void **d0, void **d1, int *d2, int *d3, int *dims,
-                     int *err)
+    void af_arr_set(void *out, void *in,
+                    void *d0, void *d1, const int *d2, const int *d3, int dims,
+                    int *err)
     {
         try {
-            array *R = (array *)*out;
-            array A = *(array *)*in;
+            graph_check(out, in, d0, (dims >= 2) ? d1 : NULL);
+            array *R = (array *)out;
+            array A = *(array *)in;
 
-            array idx0 = (*(array *)*d0) - 1;
-            array idx1 = array(A.dims(1));
-            seq idx2 = span;
-            int idx3 = 0;
-
-            if (*dims >= 2) idx1 = (*(array *)*d1) - 1;
-            if (*dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
-            if (*dims >= 4) idx3 = d3[0];
+            array idx0 = (*(array *)d0) - 1;
 
-            if (*dims == 3) {
-                (*R)(idx0, idx1, idx2) = A;
+            // A single index array holds linear indices (e.g. from where)
+            if (dims == 1) {
+                (*R)(idx0) = A;
             } else {
-                if (d2[0] != d2[1]) {
-                    printf("When using 4d indexing, last two dimensions should be integers\n");
-                    exit(-1);
+                array idx1 = (*(array *)d1) - 1;
+                seq idx2 = span;
+
+                if (dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
+
+                if (dims <= 3) {
+                    (*R)(idx0, idx1, idx2) = A;
+                } else {
+                    if (d2[0] != d2[1]) {
+                        printf("When using 4d indexing, last two dimensions should be integers\n");
+                        exit(-1);
+                    }
+                    int lastdim = d3[0] * R->dims(2) + d2[0];
+                    (*R)(idx0, idx1, lastdim) = A;
                 }
-                int lastdim = idx3 * R->dims(2) + d2[0];
-                (*R)(idx0, idx1, lastdim) = A;
             }
 
         } catch (af::exception& ex) {
@@ -743,20 +1489,21 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_set2_(void **out, void **in,
-                     void **d0, int *d1, int *d2, int *dims,
+    void af_arr_set2(void *out, void *in,
+                     void *d0, const int *d1, const int *d2, int dims,
                      int *err)
     {
         try {
-            array *R = (array *)*out;
-            array A = *(array *)*in;
+            graph_check(out, in, d0);
+            array *R = (array *)out;
+            array A = *(array *)in;
 
-            array idx0 = (*(array *)*d0) - 1;
+            array idx0 = (*(array *)d0) - 1;
             seq idx1 = span;
             seq idx2 = span;
 
-            if (*dims >= 2) idx1 = seq(d1[0], d1[2], d1[1]);
-            if (*dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
+            if (dims >= 2) idx1 = seq(d1[0], d1[2], d1[1]);
+            if (dims >= 3) idx2 = seq(d2[0], d2[2], d2[1]);
 
             (*R)(idx0, idx1, idx2) = A;
         } catch (af::exception& ex) {
@@ -766,24 +1513,24 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_set_seq_(void **out, void **in,
-                         int *d0, int *d1, int *d2, int *d3,
-                         int *dim, int *err)
+    void af_arr_set_seq(void *out, void *in,
+                        const int *d0, const int *d1, const int *d2, const int *d3,
+                        int dim, int *err)
     {
         try {
-            array *R = (array *)*out;
-            array A = *(array *)*in;
-
             seq s0 = seq(d0[0], d0[2], d0[1]);
             seq s1 = span;
             seq s2 = span;
             seq s3 = span;
 
-            if (*dim >= 2) s1 = seq(d1[0], d1[2], d1[1]);
-            if (*dim >= 3) s2 = seq(d2[0], d2[2], d2[1]);
-            if (*dim >= 4) s3 = seq(d3[0], d3[2], d3[1]);
+            if (dim >= 2) s1 = seq(d1[0], d1[2], d1[1]);
+            if (dim >= 3) s2 = seq(d2[0], d2[2], d2[1]);
+            if (dim >= 4) s3 = seq(d3[0], d3[2], d3[1]);
 
-            (*R)(s0, s1, s2, s3) = A;
+            apply_inplace(out, in,
+                          [=](array &R, const array &, const array &A) {
+                              R(s0, s1, s2, s3) = A;
+                          });
         } catch (af::exception& ex) {
             *err = 12;
             printf("%s\n", ex.what());
@@ -791,13 +1538,13 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_idx_seq_(void **out, int *first, int *last, int *step, int *err)
+    void af_idx_seq(void **out, int first, int last, int step, int *err)
     {
         try {
             *out = (void *)new array();
             array *R = (array *)*out;
-            *R = array(seq(*first, *step, *last));
-            vec_add((void *)out);
+            *R = array(seq(first, step, last));
+            vec_add(*out);
         } catch (af::exception& ex) {
             *err = 12;
             printf("%s\n", ex.what());
@@ -805,13 +1552,13 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_idx_vec_(void **out, int* indices, int *numel, int *err)
+    void af_idx_vec(void **out, const int *indices, int numel, int *err)
     {
         try {
             *out = (void *)new array();
             array *R = (array *)*out;
-            *R = array(*numel, indices, afHost).as(f32);
-            vec_add((void *)out);
+            *R = array(numel, indices, afHost).as(f32);
+            vec_add(*out);
         } catch (af::exception& ex) {
             *err = 12;
             printf("%s\n", ex.what());
@@ -819,15 +1566,14 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_join_(int *dim, void **out, void **in1, void **in2, int *err)
+    void af_arr_join(int dim, void **out, void *in1, void *in2, int *err)
     {
         try {
-            *out = (void *)new array();
-            array *R = (array *)*out;
-            array *F = (array *)*in1;
-            array *S = (array *)*in2;
-            *R = join(*dim -1, *F, *S);
-            vec_add((void *)out, *in1, *in2);
+            int d = dim - 1;
+            apply(out, in1, in2,
+                  [=](array &R, const array &F, const array &S) {
+                      R = join(d, F, S);
+                  });
         } catch (af::exception& ex) {
             *err = 12;
             printf("%s\n", ex.what());
@@ -835,10 +1581,111 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void init_post_(void **in, int *shape, int *rank)
+    // Operations going through apply() between graph_begin and graph_end are
+    // recorded. Replaying the graph reuses the same slots and rebuilds the same
+    // JIT trees, so the compiled kernels are found in the ArrayFire cache.
+    void af_graph_begin(void **g, void *const *inputs, int n, int *err)
+    {
+        if (capturing) {
+            *err = 15;
+            printf("graph_begin: another graph is being recorded\n");
+            exit(-1);
+        }
+
+        Graph *G = new Graph();
+        for (int i = 0; i < n; i++) {
+            int slot = graph_slot(G, *(array *)inputs[i], false);
+            G->handles[inputs[i]] = slot;
+            G->inputs.push_back(slot);
+        }
+
+        capturing = G;
+        *g = (void *)G;
+    }
+
+    void af_graph_end(void *g, void *const *outputs, int n, int *err)
+    {
+        Graph *G = (Graph *)g;
+        if (G == NULL || G != capturing) {
+            *err = 15;
+            printf("graph_end: graph is not being recorded\n");
+            exit(-1);
+        }
+
+        for (int i = 0; i < n; i++) {
+            G->outputs.push_back(graph_input(G, outputs[i]));
+        }
+
+        G->handles.clear();
+        capturing = NULL;
+    }
+
+    // Outputs that already hold an array are overwritten in place
+    void af_graph_run(void *g, void *const *inputs, int nin,
+                      void **outputs, int nout, int *err)
+    {
+        try {
+            static const array none;
+            Graph *G = (Graph *)g;
+
+            if (G == NULL || G == capturing ||
+                nin  != (int)G->inputs.size() ||
+                nout != (int)G->outputs.size()) {
+                *err = 15;
+                printf("graph_run: graph does not match the inputs and outputs\n");
+                exit(-1);
+            }
+
+            for (int i = 0; i < nin; i++) {
+                G->slots[G->inputs[i]] = *(array *)inputs[i];
+            }
+
+            for (size_t k = 0; k < G->steps.size(); k++) {
+                Step &st = G->steps[k];
+                st.fn(G->slots[st.out],
+                      st.in1 < 0 ? none : G->slots[st.in1],
+                      st.in2 < 0 ? none : G->slots[st.in2],
+                      st.in3 < 0 ? none : G->slots[st.in3]);
+            }
+
+            for (int i = 0; i < nout; i++) {
+                array &res = G->slots[G->outputs[i]];
+                // Outputs are named fortran arrays, they are not put in vec
+                if (outputs[i]) {
+                    *(array *)outputs[i] = res;
+                } else {
+                    outputs[i] = (void *)new array(res);
+                }
+                graph_forget(outputs[i]);
+                ((array *)outputs[i])->eval();
+            }
+
+            // Release intermediates so they do not pin device memory between runs
+            for (size_t i = 0; i < G->slots.size(); i++) {
+                if (G->temp[i]) G->slots[i] = array();
+            }
+            for (int i = 0; i < nin; i++) {
+                G->slots[G->inputs[i]] = array();
+            }
+        } catch (af::exception& ex) {
+            *err = 15;
+            printf("%s\n", ex.what());
+            exit(-1);
+        }
+    }
+
+    void af_graph_free(void **g)
+    {
+        Graph *G = (Graph *)*g;
+        if (G == capturing) capturing = NULL;
+        delete G;
+        *g = NULL;
+    }
+
+    void init_post(void *in, int *shape, int *rank)
     {
         try {
-            array *R = (array *)*in;
+            array *R = (array *)in;
             for (int i = 0; i < 4; i++) shape[i] = R->dims(i);
             *rank = R->numdims();
         } catch (af::exception& ex) {
@@ -847,10 +1694,10 @@ void af_arr_constant_(void **ptr, int *val, int *x, int *fty, int *err)
         }
     }
 
-    void af_arr_print_(void **ptr, int *err)
+    void af_arr_print(void *ptr, int *err)
     {
         try {
-            array *tmp = (array *)*ptr;
+            array *tmp = (array *)ptr;
             af::print("", *tmp);
         } catch (af::exception& ex) {
             *err = 4;